@@ -4,6 +4,7 @@ namespace writable = cpp11::writable;
 
 #include <GeographicLib/AlbersEqualArea.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -13,7 +14,8 @@ using namespace GeographicLib;
 [[cpp11::register]]
 cpp11::writable::data_frame albers_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
                                             cpp11::doubles lon0,
-                                            double stdlat1, double stdlat2, double k1) {
+                                            double stdlat1, double stdlat2, double k1,
+                                            int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -25,15 +27,24 @@ cpp11::writable::data_frame albers_fwd_cpp(cpp11::doubles lon, cpp11::doubles la
   const AlbersEqualArea albers(Constants::WGS84_a(), Constants::WGS84_f(),
                                 stdlat1, stdlat2, k1);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    albers.Forward(lon0[i], lat[i], lon[i], xx, yy, gamma, k);
-    
-    x[i] = xx;
-    y[i] = yy;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plon0 = REAL(lon0);
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      albers.Forward(plon0[i], plat[i], plon[i], xx, yy, gamma, k);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -52,7 +63,8 @@ cpp11::writable::data_frame albers_fwd_cpp(cpp11::doubles lon, cpp11::doubles la
 [[cpp11::register]]
 cpp11::writable::data_frame albers_rev_cpp(cpp11::doubles x, cpp11::doubles y,
                                             cpp11::doubles lon0,
-                                            double stdlat1, double stdlat2, double k1) {
+                                            double stdlat1, double stdlat2, double k1,
+                                            int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -63,15 +75,24 @@ cpp11::writable::data_frame albers_rev_cpp(cpp11::doubles x, cpp11::doubles y,
   const AlbersEqualArea albers(Constants::WGS84_a(), Constants::WGS84_f(),
                                 stdlat1, stdlat2, k1);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    albers.Reverse(lon0[i], x[i], y[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plon0 = REAL(lon0);
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      albers.Reverse(plon0[i], px[i], py[i], la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
@@ -90,7 +111,8 @@ cpp11::writable::data_frame albers_rev_cpp(cpp11::doubles x, cpp11::doubles y,
 [[cpp11::register]]
 cpp11::writable::data_frame albers_fwd_single_cpp(cpp11::doubles lon, cpp11::doubles lat,
                                                    cpp11::doubles lon0,
-                                                   double stdlat, double k0) {
+                                                   double stdlat, double k0,
+                                                   int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -102,15 +124,24 @@ cpp11::writable::data_frame albers_fwd_single_cpp(cpp11::doubles lon, cpp11::dou
   const AlbersEqualArea albers(Constants::WGS84_a(), Constants::WGS84_f(),
                                 stdlat, k0);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    albers.Forward(lon0[i], lat[i], lon[i], xx, yy, gamma, k);
-    
-    x[i] = xx;
-    y[i] = yy;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plon0 = REAL(lon0);
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      albers.Forward(plon0[i], plat[i], plon[i], xx, yy, gamma, k);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -129,7 +160,8 @@ cpp11::writable::data_frame albers_fwd_single_cpp(cpp11::doubles lon, cpp11::dou
 [[cpp11::register]]
 cpp11::writable::data_frame albers_rev_single_cpp(cpp11::doubles x, cpp11::doubles y,
                                                    cpp11::doubles lon0,
-                                                   double stdlat, double k0) {
+                                                   double stdlat, double k0,
+                                                   int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -140,15 +172,24 @@ cpp11::writable::data_frame albers_rev_single_cpp(cpp11::doubles x, cpp11::doubl
   const AlbersEqualArea albers(Constants::WGS84_a(), Constants::WGS84_f(),
                                 stdlat, k0);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    albers.Reverse(lon0[i], x[i], y[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plon0 = REAL(lon0);
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      albers.Reverse(plon0[i], px[i], py[i], la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
@@ -23,13 +23,18 @@ cpp11::writable::data_frame azimuthaleq_fwd_cpp(cpp11::doubles lon, cpp11::doubl
   const Geodesic& geod = Geodesic::WGS84();
   AzimuthalEquidistant proj(geod);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, azz, rkk;
-    proj.Forward(lat0[i], lon0[i], lat[i], lon[i], xx, yy, azz, rkk);
-    x[i] = xx;
-    y[i] = yy;
-    azi[i] = azz;
-    rk[i] = rkk;
+  // Project each run of points sharing a center together so that the center
+  // is only set up once per run (usually once for the whole input)
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  const double* plon0 = REAL(lon0);
+  const double* plat0 = REAL(lat0);
+  for (size_t i = 0; i < nn; ) {
+    size_t j = i + 1;
+    while (j < nn && plat0[j] == plat0[i] && plon0[j] == plon0[i]) j++;
+    proj.Forward(plat0[i], plon0[i], plat + i, plon + i, j - i,
+                 REAL(x) + i, REAL(y) + i, REAL(azi) + i, REAL(rk) + i);
+    i = j;
   }
   
   writable::data_frame out({
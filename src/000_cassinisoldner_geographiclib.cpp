@@ -5,6 +5,7 @@ namespace writable = cpp11::writable;
 #include <GeographicLib/CassiniSoldner.hpp>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -12,7 +13,7 @@ using namespace GeographicLib;
 // Forward: Geographic (lon/lat) to Cassini-Soldner (x/y)
 [[cpp11::register]]
 cpp11::writable::data_frame cassini_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                             double lon0, double lat0) {
+                                             double lon0, double lat0, int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -24,15 +25,23 @@ cpp11::writable::data_frame cassini_fwd_cpp(cpp11::doubles lon, cpp11::doubles l
   const Geodesic& geod = Geodesic::WGS84();
   CassiniSoldner cs(lat0, lon0, geod);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, azz, rkk;
-    cs.Forward(lat[i], lon[i], xx, yy, azz, rkk);
-    
-    x[i] = xx;
-    y[i] = yy;
-    azi[i] = azz;
-    rk[i] = rkk;
-  }
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pazi = REAL(azi);
+  double* prk = REAL(rk);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, azz, rkk;
+      cs.Forward(plat[i], plon[i], xx, yy, azz, rkk);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pazi[i] = azz;
+      prk[i] = rkk;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -49,7 +58,7 @@ cpp11::writable::data_frame cassini_fwd_cpp(cpp11::doubles lon, cpp11::doubles l
 // Reverse: Cassini-Soldner (x/y) to Geographic (lon/lat)
 [[cpp11::register]]
 cpp11::writable::data_frame cassini_rev_cpp(cpp11::doubles x, cpp11::doubles y,
-                                             double lon0, double lat0) {
+                                             double lon0, double lat0, int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -60,15 +69,23 @@ cpp11::writable::data_frame cassini_rev_cpp(cpp11::doubles x, cpp11::doubles y,
   const Geodesic& geod = Geodesic::WGS84();
   CassiniSoldner cs(lat0, lon0, geod);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, azz, rkk;
-    cs.Reverse(x[i], y[i], la, lo, azz, rkk);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    azi[i] = azz;
-    rk[i] = rkk;
-  }
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pazi = REAL(azi);
+  double* prk = REAL(rk);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, azz, rkk;
+      cs.Reverse(px[i], py[i], la, lo, azz, rkk);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pazi[i] = azz;
+      prk[i] = rkk;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
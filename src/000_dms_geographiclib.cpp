@@ -3,32 +3,54 @@ using namespace cpp11;
 namespace writable = cpp11::writable;
 
 #include <string>
+#include <string_view>
+#include <vector>
 #include <GeographicLib/DMS.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
 
+// The strings of a character vector as views of the CHARSXPs, with a null
+// data pointer for NA; taken on the main thread for the workers
+static vector<string_view> dms_views(cpp11::strings input) {
+  size_t nn = input.size();
+  vector<string_view> views(nn);
+  for (size_t i = 0; i < nn; i++) {
+    SEXP s = STRING_ELT(input, i);
+    if (s == NA_STRING) continue;
+    views[i] = string_view(CHAR(s), LENGTH(s));
+  }
+  return views;
+}
+
 // Parse a DMS string and return the angle in degrees
 // Also returns the hemisphere indicator (0=NONE, 1=LATITUDE, 2=LONGITUDE)
 [[cpp11::register]]
-cpp11::writable::data_frame dms_decode_cpp(cpp11::strings input) {
+cpp11::writable::data_frame dms_decode_cpp(cpp11::strings input, int nthreads) {
   size_t nn = input.size();
   
   writable::doubles angle(nn);
   writable::integers indicator(nn);
+  vector<string_view> views = dms_views(input);
   
-  for (size_t i = 0; i < nn; i++) {
-    try {
-      std::string s(input[i]);
-      DMS::flag ind;
-      double deg = DMS::Decode(s, ind);
-      angle[i] = deg;
-      indicator[i] = static_cast<int>(ind);
-    } catch (...) {
-      angle[i] = NA_REAL;
-      indicator[i] = NA_INTEGER;
+  const string_view* pviews = views.data();
+  double* pangle = REAL(angle);
+  int* pindicator = INTEGER(indicator);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      pangle[i] = NA_REAL;
+      pindicator[i] = NA_INTEGER;
+      if (!pviews[i].data()) continue;
+      try {
+        DMS::flag ind;
+        double deg = DMS::Decode(pviews[i].data(), pviews[i].size(), ind);
+        pangle[i] = deg;
+        pindicator[i] = static_cast<int>(ind);
+      } catch (...) {
+      }
     }
-  }
+  });
   
   writable::data_frame out({
     "angle"_nm = angle,
@@ -42,25 +64,34 @@ cpp11::writable::data_frame dms_decode_cpp(cpp11::strings input) {
 [[cpp11::register]]
 cpp11::writable::data_frame dms_decode_latlon_cpp(cpp11::strings dmsa, 
                                                    cpp11::strings dmsb,
-                                                   cpp11::logicals longfirst) {
+                                                   cpp11::logicals longfirst,
+                                                   int nthreads) {
   size_t nn = dmsa.size();
   
   writable::doubles lat(nn);
   writable::doubles lon(nn);
+  vector<string_view> va = dms_views(dmsa), vb = dms_views(dmsb);
   
-  for (size_t i = 0; i < nn; i++) {
-    try {
-      std::string sa(dmsa[i]);
-      std::string sb(dmsb[i]);
-      double lat_out, lon_out;
-      DMS::DecodeLatLon(sa, sb, lat_out, lon_out, longfirst[i] == TRUE);
-      lat[i] = lat_out;
-      lon[i] = lon_out;
-    } catch (...) {
-      lat[i] = NA_REAL;
-      lon[i] = NA_REAL;
+  const string_view* pa = va.data();
+  const string_view* pb = vb.data();
+  const int* plongfirst = LOGICAL(longfirst);
+  double* plat = REAL(lat);
+  double* plon = REAL(lon);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      plat[i] = NA_REAL;
+      plon[i] = NA_REAL;
+      if (!pa[i].data() || !pb[i].data()) continue;
+      try {
+        double lat_out, lon_out;
+        DMS::DecodeLatLon(pa[i].data(), pa[i].size(), pb[i].data(), pb[i].size(),
+                          lat_out, lon_out, plongfirst[i] == TRUE);
+        plat[i] = lat_out;
+        plon[i] = lon_out;
+      } catch (...) {
+      }
     }
-  }
+  });
   
   writable::data_frame out({
     "lat"_nm = lat,
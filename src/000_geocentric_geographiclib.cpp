@@ -3,6 +3,7 @@ using namespace cpp11;
 namespace writable = cpp11::writable;
 
 #include <GeographicLib/Geocentric.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -10,7 +11,7 @@ using namespace GeographicLib;
 // Forward: Geographic (lon/lat/h) to Geocentric (X/Y/Z)
 [[cpp11::register]]
 cpp11::writable::data_frame geocentric_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                                cpp11::doubles h) {
+                                                cpp11::doubles h, int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles X(nn);
@@ -19,13 +20,16 @@ cpp11::writable::data_frame geocentric_fwd_cpp(cpp11::doubles lon, cpp11::double
   
   const Geocentric& earth = Geocentric::WGS84();
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, zz;
-    earth.Forward(lat[i], lon[i], h[i], xx, yy, zz);
-    X[i] = xx;
-    Y[i] = yy;
-    Z[i] = zz;
-  }
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  const double* ph = REAL(h);
+  double* pX = REAL(X);
+  double* pY = REAL(Y);
+  double* pZ = REAL(Z);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    earth.Forward(plat + i0, plon + i0, ph + i0, i1 - i0,
+                  pX + i0, pY + i0, pZ + i0);
+  });
   
   writable::data_frame out({
     "X"_nm = X,
@@ -42,7 +46,7 @@ cpp11::writable::data_frame geocentric_fwd_cpp(cpp11::doubles lon, cpp11::double
 // Reverse: Geocentric (X/Y/Z) to Geographic (lon/lat/h)
 [[cpp11::register]]
 cpp11::writable::data_frame geocentric_rev_cpp(cpp11::doubles X, cpp11::doubles Y,
-                                                cpp11::doubles Z) {
+                                                cpp11::doubles Z, int nthreads) {
   size_t nn = X.size();
   
   writable::doubles lon(nn);
@@ -51,13 +55,16 @@ cpp11::writable::data_frame geocentric_rev_cpp(cpp11::doubles X, cpp11::doubles
   
   const Geocentric& earth = Geocentric::WGS84();
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, hh;
-    earth.Reverse(X[i], Y[i], Z[i], la, lo, hh);
-    lon[i] = lo;
-    lat[i] = la;
-    h[i] = hh;
-  }
+  const double* pX = REAL(X);
+  const double* pY = REAL(Y);
+  const double* pZ = REAL(Z);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* ph = REAL(h);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    earth.Reverse(pX + i0, pY + i0, pZ + i0, i1 - i0,
+                  plat + i0, plon + i0, ph + i0);
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
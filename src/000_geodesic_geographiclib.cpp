@@ -2,9 +2,11 @@
 using namespace cpp11;
 namespace writable = cpp11::writable;
 
+#include <vector>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicLine.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -166,24 +168,32 @@ cpp11::writable::doubles geodesic_distance_fast_cpp(cpp11::doubles lon1, cpp11::
   return dist;
 }
 
-// Distance matrix
+// Distance matrix (n1 x n2, column-major)
+// Tiled across worker threads; with symmetric = TRUE the two point sets are
+// the same and only the upper triangle is solved, then mirrored
 [[cpp11::register]]
 cpp11::writable::doubles geodesic_distance_matrix_fast_cpp(cpp11::doubles lon1, cpp11::doubles lat1,
-                                                            cpp11::doubles lon2, cpp11::doubles lat2) {
+                                                            cpp11::doubles lon2, cpp11::doubles lat2,
+                                                            bool symmetric, int nthreads) {
   size_t n1 = lon1.size();
   size_t n2 = lon2.size();
   
+  // Copy coordinates on the main thread; workers only see plain arrays
+  vector<double> la1(lat1.begin(), lat1.end()), lo1(lon1.begin(), lon1.end());
+  vector<double> la2(lat2.begin(), lat2.end()), lo2(lon2.begin(), lon2.end());
+  
   writable::doubles dist(n1 * n2);
+  double* out = REAL(dist);
   
   const Geodesic& geod = Geodesic::WGS84();
   
-  for (size_t i = 0; i < n1; i++) {
-    for (size_t j = 0; j < n2; j++) {
-      double s12;
-      geod.Inverse(lat1[i], lon1[i], lat2[j], lon2[j], s12);
-      dist[i * n2 + j] = s12;
-    }
-  }
+  // Each row segment shares point i, so set it up once as the origin
+  geographiclib_r::distance_matrix_rows(n1, n2, symmetric && n1 == n2, nthreads, out,
+    [&](size_t i, size_t j0, size_t j1, double* buf) {
+      geod.InverseFrom(la1[i], lo1[i])
+        .Inverse(&la2[j0], &lo2[j0], j1 - j0, buf);
+    });
   
+  dist.attr("dim") = writable::integers({static_cast<int>(n1), static_cast<int>(n2)});
   return dist;
 }
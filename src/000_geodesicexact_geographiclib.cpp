@@ -3,9 +3,11 @@ using namespace cpp11;
 namespace writable = cpp11::writable;
 
 #include <string>
+#include <vector>
 #include <GeographicLib/GeodesicExact.hpp>
 #include <GeographicLib/GeodesicLineExact.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -186,25 +188,32 @@ cpp11::writable::data_frame geodesic_line_cpp(double lon1, double lat1,
 }
 
 // Compute distance matrix between two sets of points
-// Returns a vector in row-major order (for reshaping to matrix in R)
+// Returns an n1 x n2 matrix, tiled across worker threads; with
+// symmetric = TRUE only the upper triangle is solved, then mirrored
 [[cpp11::register]]
 cpp11::writable::doubles geodesic_distance_matrix_cpp(cpp11::doubles lon1, cpp11::doubles lat1,
-                                                       cpp11::doubles lon2, cpp11::doubles lat2) {
+                                                       cpp11::doubles lon2, cpp11::doubles lat2,
+                                                       bool symmetric, int nthreads) {
   size_t n1 = lon1.size();
   size_t n2 = lon2.size();
   
+  // Copy coordinates on the main thread; workers only see plain arrays
+  vector<double> la1(lat1.begin(), lat1.end()), lo1(lon1.begin(), lon1.end());
+  vector<double> la2(lat2.begin(), lat2.end()), lo2(lon2.begin(), lon2.end());
+  
   writable::doubles dist(n1 * n2);
+  double* out = REAL(dist);
   
   const GeodesicExact& geod = GeodesicExact::WGS84();
   
-  for (size_t i = 0; i < n1; i++) {
-    for (size_t j = 0; j < n2; j++) {
+  geographiclib_r::distance_matrix(n1, n2, symmetric && n1 == n2, nthreads, out,
+    [&](size_t i, size_t j) {
       double s12;
-      geod.Inverse(lat1[i], lon1[i], lat2[j], lon2[j], s12);
-      dist[i * n2 + j] = s12;
-    }
-  }
+      geod.Inverse(la1[i], lo1[i], la2[j], lo2[j], s12);
+      return s12;
+    });
   
+  dist.attr("dim") = writable::integers({static_cast<int>(n1), static_cast<int>(n2)});
   return dist;
 }
 
@@ -2,8 +2,13 @@
 using namespace cpp11;
 namespace writable = cpp11::writable;
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <GeographicLib/Geohash.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -97,3 +102,396 @@ int geohash_length_for_precision_cpp(double resolution) {
 int geohash_length_for_precisions_cpp(double lat_resolution, double lon_resolution) {
   return Geohash::GeohashLength(lat_resolution, lon_resolution);
 }
+
+// Integer codes travel to and from R in double vectors: as their value
+// (exact up to 2^53, i.e., 10 characters) or, with int64 = true, as the bits
+// of a signed 64-bit integer, the representation of bit64's integer64.
+// Geohash::invalidint_ is NA either way.
+static double geohash_code_to_double(unsigned long long c, bool int64) {
+  if (!int64) return c == Geohash::invalidint_ ? NA_REAL : double(c);
+  int64_t v = c == Geohash::invalidint_ ? INT64_MIN : int64_t(c);
+  double d;
+  memcpy(&d, &v, sizeof d);
+  return d;
+}
+
+static unsigned long long geohash_code_from_double(double d, bool int64) {
+  if (!int64)
+    return d >= 0 && d == floor(d) && d < 18446744073709551616.0 ?
+      (unsigned long long)(d) : Geohash::invalidint_;
+  int64_t v;
+  memcpy(&v, &d, sizeof v);
+  return v < 0 ? Geohash::invalidint_ : (unsigned long long)(v);
+}
+
+// Forward: Geographic (lon/lat) to integer geohash codes of length len
+[[cpp11::register]]
+cpp11::writable::doubles geohash_fwd_int_cpp(cpp11::doubles lon, cpp11::doubles lat,
+                                             int len, bool int64, int nthreads) {
+  size_t nn = lon.size();
+
+  writable::doubles code(nn);
+
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  double* pcode = REAL(code);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    unsigned long long buf[256];
+    for (size_t j0 = i0; j0 < i1; j0 += 256) {
+      size_t m = min(size_t(256), i1 - j0);
+      Geohash::ForwardInt(plat + j0, plon + j0, m, len, buf);
+      for (size_t j = 0; j < m; j++)
+        pcode[j0 + j] = geohash_code_to_double(buf[j], int64);
+    }
+  });
+
+  return code;
+}
+
+// Reverse: integer geohash codes of length len to Geographic (lon/lat),
+// with the same columns as geohash_rev_cpp
+[[cpp11::register]]
+cpp11::writable::data_frame geohash_rev_int_cpp(cpp11::doubles code, int len,
+                                                bool int64, int nthreads) {
+  size_t nn = code.size();
+
+  writable::doubles lon(nn);
+  writable::doubles lat(nn);
+  writable::integers length(nn);
+  writable::doubles lat_resolution(nn);
+  writable::doubles lon_resolution(nn);
+
+  const double* pcode = REAL(code);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    unsigned long long buf[256];
+    for (size_t j0 = i0; j0 < i1; j0 += 256) {
+      size_t m = min(size_t(256), i1 - j0);
+      for (size_t j = 0; j < m; j++)
+        buf[j] = geohash_code_from_double(pcode[j0 + j], int64);
+      Geohash::ReverseInt(buf, m, len, plat + j0, plon + j0);
+    }
+  });
+  fill(INTEGER(length), INTEGER(length) + nn, len);
+  fill(REAL(lat_resolution), REAL(lat_resolution) + nn, Geohash::LatitudeResolution(len));
+  fill(REAL(lon_resolution), REAL(lon_resolution) + nn, Geohash::LongitudeResolution(len));
+
+  writable::data_frame out({
+    "lon"_nm = lon,
+    "lat"_nm = lat,
+    "len"_nm = length,
+    "lat_resolution"_nm = lat_resolution,
+    "lon_resolution"_nm = lon_resolution
+  });
+
+  return out;
+}
+
+// Integer geohash codes of length len to strings
+[[cpp11::register]]
+cpp11::writable::strings geohash_int_string_cpp(cpp11::doubles code, int len,
+                                                bool int64) {
+  size_t nn = code.size();
+
+  writable::strings geohash(nn);
+
+  const double* pcode = REAL(code);
+  string gh;
+  for (size_t i = 0; i < nn; i++) {
+    unsigned long long c = geohash_code_from_double(pcode[i], int64);
+    if (c == Geohash::invalidint_) {
+      geohash[i] = NA_STRING;
+      continue;
+    }
+    Geohash::IntToString(c, len, gh);
+    geohash[i] = gh;
+  }
+
+  return geohash;
+}
+
+// The eight neighbors of a cell, clockwise from north.  Columns wrap around
+// the antimeridian; rows stop at the poles, where a neighbor is invalid.
+static const int geohash_dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const int geohash_dy[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+
+static void geohash_neighbors(unsigned long long code, int len,
+                              unsigned long long nbr[8]) {
+  unsigned long long ix, iy;
+  if (!Geohash::IntToCell(code, len, ix, iy)) {
+    fill(nbr, nbr + 8, Geohash::invalidint_);
+    return;
+  }
+  const unsigned long long
+    ncol = 1ULL << Geohash::LongitudeBits(len),
+    nrow = 1ULL << Geohash::LatitudeBits(len);
+  for (int k = 0; k < 8; k++) {
+    if ((geohash_dy[k] < 0 && iy == 0) || (geohash_dy[k] > 0 && iy == nrow - 1)) {
+      nbr[k] = Geohash::invalidint_;
+      continue;
+    }
+    nbr[k] = Geohash::CellToInt((ix + ncol + geohash_dx[k]) & (ncol - 1),
+                                iy + geohash_dy[k], len);
+  }
+}
+
+// Neighbors of integer geohash codes of length len
+[[cpp11::register]]
+cpp11::writable::data_frame geohash_neighbors_int_cpp(cpp11::doubles code, int len,
+                                                      bool int64, int nthreads) {
+  size_t nn = code.size();
+
+  vector<writable::doubles> nbr;
+  vector<double*> pnbr;
+  for (int k = 0; k < 8; k++) {
+    nbr.emplace_back(nn);
+    pnbr.push_back(REAL(nbr.back()));
+  }
+
+  const double* pcode = REAL(code);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    unsigned long long buf[8];
+    for (size_t i = i0; i < i1; i++) {
+      geohash_neighbors(geohash_code_from_double(pcode[i], int64), len, buf);
+      for (int k = 0; k < 8; k++)
+        pnbr[k][i] = geohash_code_to_double(buf[k], int64);
+    }
+  });
+
+  writable::data_frame out({
+    "n"_nm = nbr[0], "ne"_nm = nbr[1], "e"_nm = nbr[2], "se"_nm = nbr[3],
+    "s"_nm = nbr[4], "sw"_nm = nbr[5], "w"_nm = nbr[6], "nw"_nm = nbr[7]
+  });
+
+  return out;
+}
+
+// Neighbors of Geohash strings, each of its own length (up to 12)
+[[cpp11::register]]
+cpp11::writable::data_frame geohash_neighbors_cpp(cpp11::strings geohash) {
+  size_t nn = geohash.size();
+
+  vector<writable::strings> nbr;
+  for (int k = 0; k < 8; k++) nbr.emplace_back(nn);
+
+  unsigned long long buf[8];
+  string gh;
+  for (size_t i = 0; i < nn; i++) {
+    int len = 0;
+    unsigned long long c = geohash[i] == NA_STRING ? Geohash::invalidint_ :
+      Geohash::StringToInt(string(geohash[i]), len);
+    geohash_neighbors(c, len, buf);
+    for (int k = 0; k < 8; k++) {
+      if (buf[k] == Geohash::invalidint_) {
+        nbr[k][i] = NA_STRING;
+      } else {
+        Geohash::IntToString(buf[k], len, gh);
+        nbr[k][i] = gh;
+      }
+    }
+  }
+
+  writable::data_frame out({
+    "n"_nm = nbr[0], "ne"_nm = nbr[1], "e"_nm = nbr[2], "se"_nm = nbr[3],
+    "s"_nm = nbr[4], "sw"_nm = nbr[5], "w"_nm = nbr[6], "nw"_nm = nbr[7]
+  });
+
+  return out;
+}
+
+// Above this many cells a cover is refused rather than allocated
+static const double geohash_max_cover = 1e7;
+
+// The columns [ix0, ix0 + nx) (modulo the number of columns) and rows
+// [iy0, iy1] of the cells of length len meeting a box.  A maximum on a cell
+// boundary does not bring in the cell beyond it.
+static void geohash_cell_range(double xmin, double xmax, double ymin, double ymax,
+                               int len, unsigned long long& ix0, unsigned long long& nx,
+                               unsigned long long& iy0, unsigned long long& iy1) {
+  const double
+    ncol = ldexp(1.0, Geohash::LongitudeBits(len)),
+    nrow = ldexp(1.0, Geohash::LatitudeBits(len));
+  if (xmax - xmin >= Math::td) {
+    ix0 = 0;
+    nx = (unsigned long long)(ncol);
+  } else {
+    xmin = Math::AngNormalize(xmin);
+    if (xmin == Math::hd) xmin = -Math::hd;
+    xmax = xmin + Math::AngNormalize(xmax - xmin);
+    if (xmax < xmin) xmax += Math::td;
+    double fx0 = floor((xmin + Math::hd) / Math::td * ncol),
+      fx1 = max(fx0, ceil((xmax + Math::hd) / Math::td * ncol) - 1);
+    ix0 = (unsigned long long)(fx0);
+    nx = (unsigned long long)(min(ncol, fx1 - fx0 + 1));
+  }
+  double fy0 = floor((ymin + Math::qd) / Math::hd * nrow),
+    fy1 = ceil((ymax + Math::qd) / Math::hd * nrow) - 1;
+  fy0 = min(nrow - 1, max(0.0, fy0));
+  fy1 = min(nrow - 1, max(fy0, fy1));
+  iy0 = (unsigned long long)(fy0);
+  iy1 = (unsigned long long)(fy1);
+}
+
+static void geohash_check_cover(unsigned long long nx, unsigned long long iy0,
+                                unsigned long long iy1) {
+  if (double(nx) * double(iy1 - iy0 + 1) > geohash_max_cover)
+    throw GeographicErr("Cover needs more than 1e7 cells, use a shorter len");
+}
+
+// Cells of length len covering the box [xmin, xmax] x [ymin, ymax], in
+// increasing order.  xmin > xmax crosses the antimeridian.
+[[cpp11::register]]
+cpp11::writable::doubles geohash_cover_bbox_cpp(double xmin, double xmax,
+                                                double ymin, double ymax,
+                                                int len, bool int64) {
+  unsigned long long ix0, nx, iy0, iy1;
+  geohash_cell_range(xmin, xmax, ymin, ymax, len, ix0, nx, iy0, iy1);
+  geohash_check_cover(nx, iy0, iy1);
+  const unsigned long long ncol = 1ULL << Geohash::LongitudeBits(len);
+
+  vector<unsigned long long> cells;
+  cells.reserve(nx * (iy1 - iy0 + 1));
+  for (unsigned long long iy = iy0; iy <= iy1; iy++)
+    for (unsigned long long j = 0; j < nx; j++)
+      cells.push_back(Geohash::CellToInt((ix0 + j) & (ncol - 1), iy, len));
+  sort(cells.begin(), cells.end());
+
+  writable::doubles code(cells.size());
+  double* pcode = REAL(code);
+  for (size_t i = 0; i < cells.size(); i++)
+    pcode[i] = geohash_code_to_double(cells[i], int64);
+
+  return code;
+}
+
+// The longitude half-width of the geodesic circle of radius r about
+// (lat0, 0), not including either pole.  The easternmost point is where the
+// circle touches a meridian; it is bracketed by sampling azimuths and then
+// located by golden-section search.
+static double geohash_circle_halfwidth(const Geodesic& geod, double lat0, double r) {
+  const unsigned mask = Geodesic::LONGITUDE | Geodesic::LONG_UNROLL;
+  auto dlon = [&](double azi) {
+    double lat2, lon2, azi2, s12, m12, M12, M21, S12;
+    geod.GenDirect(lat0, 0, azi, false, r, mask,
+                   lat2, lon2, azi2, s12, m12, M12, M21, S12);
+    return lon2;
+  };
+  const int nsample = 36;
+  const double step = Math::hd / nsample;
+  int best = 1;
+  double vbest = dlon(step);
+  for (int k = 2; k < nsample; k++) {
+    double v = dlon(k * step);
+    if (v > vbest) { vbest = v; best = k; }
+  }
+  const double g = (sqrt(5.0) - 1) / 2;
+  double a = (best - 1) * step, b = (best + 1) * step,
+    c = b - g * (b - a), d = a + g * (b - a),
+    fc = dlon(c), fd = dlon(d);
+  for (int it = 0; it < 40; it++) {
+    if (fc > fd) {
+      b = d; d = c; fd = fc; c = b - g * (b - a); fc = dlon(c);
+    } else {
+      a = c; c = d; fc = fd; d = a + g * (b - a); fd = dlon(d);
+    }
+  }
+  return max(vbest, max(fc, fd));
+}
+
+// Cells of length len meeting the geodesic circle of radius r about
+// (lat0, lon0), in increasing order.  The cells in the circle's latitude
+// and longitude extent are kept unless their centers are further than r
+// plus the cell's own half-diagonal from (lat0, lon0), so the cover may
+// include a few cells just outside the circle but never misses one.
+static void geohash_cover_circle(const Geodesic& geod, double lat0, double lon0,
+                                 double r, int len,
+                                 vector<unsigned long long>& cells) {
+  cells.clear();
+  if (!(isfinite(lat0) && isfinite(lon0) && r >= 0) || fabs(lat0) > Math::qd)
+    return;
+  double s12, lat2, lon2;
+  geod.Inverse(lat0, lon0,  Math::qd, lon0, s12);
+  bool northp = s12 <= r;
+  geod.Inverse(lat0, lon0, -Math::qd, lon0, s12);
+  bool southp = s12 <= r;
+  double ymax = Math::qd, ymin = -Math::qd, xmin = -Math::hd, xmax = Math::hd;
+  if (!northp) {
+    geod.Direct(lat0, lon0, 0, r, lat2, lon2);
+    ymax = lat2;
+  }
+  if (!southp) {
+    geod.Direct(lat0, lon0, Math::hd, r, lat2, lon2);
+    ymin = lat2;
+  }
+  if (!(northp || southp)) {
+    double w = geohash_circle_halfwidth(geod, lat0, r) + 1e-9;
+    if (w < Math::hd) {
+      xmin = lon0 - w;
+      xmax = lon0 + w;
+    }
+  }
+
+  unsigned long long ix0, nx, iy0, iy1;
+  geohash_cell_range(xmin, xmax, ymin, ymax, len, ix0, nx, iy0, iy1);
+  geohash_check_cover(nx, iy0, iy1);
+  const unsigned long long ncol = 1ULL << Geohash::LongitudeBits(len);
+  const double
+    dx = Geohash::LongitudeResolution(len),
+    dy = Geohash::LatitudeResolution(len);
+  for (unsigned long long iy = iy0; iy <= iy1; iy++) {
+    // The furthest point of a cell from its center is taken to be a corner
+    // or the middle of an edge; all cells of a row share this distance
+    double yc = -Math::qd + (double(iy) + 0.5) * dy, half = 0;
+    for (int k = 0; k < 8; k++) {
+      geod.Inverse(yc, 0, yc + geohash_dy[k] * dy / 2, geohash_dx[k] * dx / 2, s12);
+      half = max(half, s12);
+    }
+    for (unsigned long long j = 0; j < nx; j++) {
+      unsigned long long ix = (ix0 + j) & (ncol - 1);
+      geod.Inverse(lat0, lon0, yc, -Math::hd + (double(ix) + 0.5) * dx, s12);
+      if (s12 <= r + half) cells.push_back(Geohash::CellToInt(ix, iy, len));
+    }
+  }
+  sort(cells.begin(), cells.end());
+}
+
+// Cells of length len covering geodesic circles of radius r, as a long
+// data frame of point index (1-based) and cell
+[[cpp11::register]]
+cpp11::writable::data_frame geohash_cover_circle_cpp(cpp11::doubles lon, cpp11::doubles lat,
+                                                     cpp11::doubles radius, int len,
+                                                     bool int64, int nthreads) {
+  size_t nn = lon.size();
+  const Geodesic& geod = Geodesic::WGS84();
+
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  const double* pradius = REAL(radius);
+  vector<vector<unsigned long long>> cells(nn);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++)
+      geohash_cover_circle(geod, plat[i], plon[i], pradius[i], len, cells[i]);
+  });
+
+  size_t ntot = 0;
+  for (size_t i = 0; i < nn; i++) ntot += cells[i].size();
+  writable::integers id(ntot);
+  writable::doubles code(ntot);
+  int* pid = INTEGER(id);
+  double* pcode = REAL(code);
+  for (size_t i = 0, j = 0; i < nn; i++) {
+    for (unsigned long long c : cells[i]) {
+      pid[j] = int(i) + 1;
+      pcode[j++] = geohash_code_to_double(c, int64);
+    }
+    vector<unsigned long long>().swap(cells[i]);
+  }
+
+  writable::data_frame out({
+    "id"_nm = id,
+    "cell"_nm = code
+  });
+
+  return out;
+}
@@ -0,0 +1,485 @@
+#include <cpp11.hpp>
+using namespace cpp11;
+namespace writable = cpp11::writable;
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/Rhumb.hpp>
+#include "000_parallel_geographiclib.h"
+
+using namespace std;
+using namespace GeographicLib;
+
+// Area, length and densification of sf geometries (sfc lists of matrices) or
+// WKB raw vectors, read where they lie in memory.  Walking the structure is
+// done on the main thread and only records, for each ring or line string,
+// where its coordinates are; the workers then read the coordinates through
+// raw pointers.
+
+// What a run of points is part of
+enum geometry_kind { GEOM_POINT = 0, GEOM_LINE = 1, GEOM_RING = 2 };
+
+// A point set, line string or polygon ring.  Its n points are read in place,
+// from an sf matrix (x and y columns of doubles) or from WKB (interleaved
+// coordinates of 2 to 4 dimensions, unaligned, possibly byte swapped).
+struct geometry_ring {
+  const unsigned char* x;
+  const unsigned char* y;
+  size_t n, stride;
+  bool swap;
+  geometry_kind kind;
+  size_t feature;
+  int part, ring;               // 0-based; ring 0 of a polygon is its exterior
+
+  static double read(const unsigned char* p, bool swap) {
+    unsigned char b[8];
+    if (swap) {
+      for (int k = 0; k < 8; k++) b[k] = p[7 - k];
+      p = b;
+    }
+    double v;
+    memcpy(&v, p, 8);
+    return v;
+  }
+  double lon(size_t i) const { return read(x + i * stride, swap); }
+  double lat(size_t i) const { return read(y + i * stride, swap); }
+};
+
+struct geometry_set {
+  size_t nfeatures = 0;
+  vector<char> missing;         // NULL features
+  vector<geometry_ring> rings;
+  size_t npoints = 0;
+};
+
+// WKB ------------------------------------------------------------------------
+
+struct wkb_cursor {
+  const unsigned char* p;
+  const unsigned char* end;
+  bool need(size_t k) const { return static_cast<size_t>(end - p) >= k; }
+  uint32_t u32(bool swap) {
+    uint32_t v;
+    if (swap) {
+      unsigned char b[4] = {p[3], p[2], p[1], p[0]};
+      memcpy(&v, b, 4);
+    } else
+      memcpy(&v, p, 4);
+    p += 4;
+    return v;
+  }
+};
+
+static bool host_big_endian() {
+  const uint16_t one = 1;
+  unsigned char b;
+  memcpy(&b, &one, 1);
+  return b == 0;
+}
+
+// Read one geometry (with its own header) into g; part counts the points,
+// line strings and polygons of the feature.  Returns false if malformed.
+static bool wkb_geometry(wkb_cursor& c, size_t feature, int& part, int depth,
+                         geometry_set& g) {
+  if (depth > 32 || !c.need(5) || c.p[0] > 1) return false;
+  // 0 = big endian (XDR), 1 = little endian (NDR)
+  bool swap = (c.p[0] == 1) == host_big_endian();
+  c.p++;
+  uint32_t type = c.u32(swap);
+  // EWKB flags, then ISO dimension offsets
+  bool z = (type & 0x80000000u) != 0, m = (type & 0x40000000u) != 0;
+  if (type & 0x20000000u) {
+    if (!c.need(4)) return false;
+    c.p += 4;                   // SRID
+  }
+  type &= 0x0fffffffu;
+  uint32_t base = type % 1000, iso = type / 1000;
+  if (iso > 3) return false;
+  if (iso == 1 || iso == 3) z = true;
+  if (iso == 2 || iso == 3) m = true;
+  size_t stride = 8 * (2 + z + m);
+  auto points = [&](size_t n, geometry_kind kind, int ring) {
+    if (n > static_cast<size_t>(c.end - c.p) / stride) return false;
+    g.rings.push_back({c.p, c.p + 8, n, stride, swap, kind, feature, part, ring});
+    g.npoints += n;
+    c.p += n * stride;
+    return true;
+  };
+  switch (base) {
+  case 1:                       // Point
+    if (!points(1, GEOM_POINT, 0)) return false;
+    part++;
+    return true;
+  case 2: {                     // LineString
+    if (!c.need(4)) return false;
+    if (!points(c.u32(swap), GEOM_LINE, 0)) return false;
+    part++;
+    return true;
+  }
+  case 3: {                     // Polygon
+    if (!c.need(4)) return false;
+    uint32_t nr = c.u32(swap);
+    for (uint32_t r = 0; r < nr; r++) {
+      if (!c.need(4)) return false;
+      if (!points(c.u32(swap), GEOM_RING, static_cast<int>(r))) return false;
+    }
+    part++;
+    return true;
+  }
+  case 4: {                     // MultiPoint, one part as in sf
+    if (!c.need(4)) return false;
+    uint32_t ng = c.u32(swap);
+    int part0 = part;
+    for (uint32_t k = 0; k < ng; k++) {
+      part = part0;
+      if (!wkb_geometry(c, feature, part, depth + 1, g)) return false;
+    }
+    part = part0 + 1;
+    return true;
+  }
+  case 5: case 6: case 7: {     // MultiLineString, MultiPolygon, collection
+    if (!c.need(4)) return false;
+    uint32_t ng = c.u32(swap);
+    for (uint32_t k = 0; k < ng; k++)
+      if (!wkb_geometry(c, feature, part, depth + 1, g)) return false;
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+static void wkb_read(cpp11::list x, geometry_set& g) {
+  size_t nn = x.size();
+  g.nfeatures = nn;
+  g.missing.assign(nn, 0);
+  for (size_t i = 0; i < nn; i++) {
+    SEXP el = VECTOR_ELT(x, i);
+    if (el == R_NilValue) {
+      g.missing[i] = 1;
+      continue;
+    }
+    if (TYPEOF(el) != RAWSXP)
+      cpp11::stop("element %d is not a raw vector", static_cast<int>(i + 1));
+    const unsigned char* p = RAW(el);
+    wkb_cursor c{p, p + Rf_xlength(el)};
+    int part = 0;
+    if (!wkb_geometry(c, i, part, 0, g))
+      cpp11::stop("malformed WKB in element %d", static_cast<int>(i + 1));
+  }
+}
+
+// sf -------------------------------------------------------------------------
+
+static void sfc_points(SEXP m, geometry_kind kind, size_t feature, int part,
+                       int ring, geometry_set& g) {
+  if (TYPEOF(m) != REALSXP)
+    cpp11::stop("coordinates of feature %d are not double",
+                static_cast<int>(feature + 1));
+  size_t n, nrow;
+  if (Rf_isMatrix(m)) {
+    if (Rf_ncols(m) < 2)
+      cpp11::stop("coordinates of feature %d have fewer than two columns",
+                  static_cast<int>(feature + 1));
+    n = nrow = Rf_nrows(m);
+  } else {
+    // POINT, a vector; an empty point has NA coordinates
+    if (Rf_xlength(m) < 2) return;
+    n = 1;
+    nrow = 1;
+  }
+  const unsigned char* x = reinterpret_cast<const unsigned char*>(REAL(m));
+  g.rings.push_back({x, x + 8 * nrow, n, 8, false, kind, feature, part, ring});
+  g.npoints += n;
+}
+
+static void sfc_geometry(SEXP s, size_t feature, int& part, geometry_set& g) {
+  SEXP cls = Rf_getAttrib(s, R_ClassSymbol);
+  if (TYPEOF(cls) != STRSXP || Rf_xlength(cls) < 2)
+    cpp11::stop("feature %d is not an sfg", static_cast<int>(feature + 1));
+  string type = CHAR(STRING_ELT(cls, 1));
+  if (type == "POINT" || type == "MULTIPOINT") {
+    sfc_points(s, GEOM_POINT, feature, part++, 0, g);
+  } else if (type == "LINESTRING") {
+    sfc_points(s, GEOM_LINE, feature, part++, 0, g);
+  } else if (type == "MULTILINESTRING") {
+    for (R_xlen_t k = 0; k < Rf_xlength(s); k++)
+      sfc_points(VECTOR_ELT(s, k), GEOM_LINE, feature, part++, 0, g);
+  } else if (type == "POLYGON") {
+    for (R_xlen_t r = 0; r < Rf_xlength(s); r++)
+      sfc_points(VECTOR_ELT(s, r), GEOM_RING, feature, part, int(r), g);
+    part++;
+  } else if (type == "MULTIPOLYGON") {
+    for (R_xlen_t k = 0; k < Rf_xlength(s); k++) {
+      SEXP poly = VECTOR_ELT(s, k);
+      for (R_xlen_t r = 0; r < Rf_xlength(poly); r++)
+        sfc_points(VECTOR_ELT(poly, r), GEOM_RING, feature, part, int(r), g);
+      part++;
+    }
+  } else if (type == "GEOMETRYCOLLECTION") {
+    for (R_xlen_t k = 0; k < Rf_xlength(s); k++)
+      sfc_geometry(VECTOR_ELT(s, k), feature, part, g);
+  } else {
+    cpp11::stop("unsupported geometry type %s in feature %d", type.c_str(),
+                static_cast<int>(feature + 1));
+  }
+}
+
+static void sfc_read(cpp11::list x, geometry_set& g) {
+  size_t nn = x.size();
+  g.nfeatures = nn;
+  g.missing.assign(nn, 0);
+  for (size_t i = 0; i < nn; i++) {
+    SEXP el = VECTOR_ELT(x, i);
+    if (el == R_NilValue) {
+      g.missing[i] = 1;
+      continue;
+    }
+    int part = 0;
+    sfc_geometry(el, i, part, g);
+  }
+}
+
+static void geometry_read(cpp11::list x, bool wkb, geometry_set& g) {
+  if (wkb)
+    wkb_read(x, g);
+  else
+    sfc_read(x, g);
+}
+
+// Split the rings into blocks of about target points for the workers
+static vector<size_t> geometry_blocks(const geometry_set& g, size_t target = 16384) {
+  vector<size_t> start(1, 0);
+  size_t count = 0;
+  for (size_t r = 0; r < g.rings.size(); r++) {
+    count += g.rings[r].n + 1;
+    if (count >= target) {
+      start.push_back(r + 1);
+      count = 0;
+    }
+  }
+  if (start.back() != g.rings.size()) start.push_back(g.rings.size());
+  return start;
+}
+
+// Measures --------------------------------------------------------------------
+
+// Signed area and perimeter of each ring, length of each line string
+template <class G>
+static void geometry_measures(const G& earth, const geometry_set& g, int nthreads,
+                              vector<double>& area, vector<double>& length) {
+  size_t nr = g.rings.size();
+  area.assign(nr, 0.0);
+  length.assign(nr, 0.0);
+  vector<size_t> blocks = geometry_blocks(g);
+  const geometry_ring* rings = g.rings.data();
+  const size_t* pblocks = blocks.data();
+  double* parea = area.data();
+  double* plength = length.data();
+  geographiclib_r::parallel_tasks(blocks.size() - 1, nthreads, [&](size_t b) {
+    PolygonAreaT<G> poly(earth, false), line(earth, true);
+    for (size_t r = pblocks[b]; r < pblocks[b + 1]; r++) {
+      const geometry_ring& ring = rings[r];
+      if (ring.kind == GEOM_POINT || ring.n == 0) continue;
+      size_t n = ring.n;
+      double perim = 0, ar = 0;
+      if (ring.kind == GEOM_RING) {
+        // Rings repeat their first point at the end
+        if (n > 1 && ring.lon(n - 1) == ring.lon(0) &&
+            ring.lat(n - 1) == ring.lat(0))
+          n--;
+        poly.Clear();
+        for (size_t i = 0; i < n; i++) poly.AddPoint(ring.lat(i), ring.lon(i));
+        poly.Compute(false, true, perim, ar);
+        parea[r] = ar;
+      } else {
+        line.Clear();
+        for (size_t i = 0; i < n; i++) line.AddPoint(ring.lat(i), ring.lon(i));
+        line.Compute(false, true, perim, ar);
+      }
+      plength[r] = perim;
+    }
+  });
+}
+
+// Area (exteriors less holes) and perimeter of each polygon feature
+[[cpp11::register]]
+cpp11::writable::data_frame geometry_area_cpp(cpp11::list x, bool wkb, bool rhumb,
+                                              int nthreads) {
+  geometry_set g;
+  geometry_read(x, wkb, g);
+  vector<double> ring_area, ring_length;
+  if (rhumb)
+    geometry_measures(Rhumb::WGS84(), g, nthreads, ring_area, ring_length);
+  else
+    geometry_measures(Geodesic::WGS84(), g, nthreads, ring_area, ring_length);
+
+  size_t nn = g.nfeatures;
+  vector<double> sum_area(nn, 0.0), sum_perimeter(nn, 0.0);
+  for (size_t r = 0; r < g.rings.size(); r++) {
+    const geometry_ring& ring = g.rings[r];
+    if (ring.kind != GEOM_RING) continue;
+    double a = fabs(ring_area[r]);
+    sum_area[ring.feature] += ring.ring == 0 ? a : -a;
+    sum_perimeter[ring.feature] += ring_length[r];
+  }
+
+  writable::doubles area(nn);
+  writable::doubles perimeter(nn);
+  for (size_t i = 0; i < nn; i++) {
+    area[i] = g.missing[i] ? NA_REAL : sum_area[i];
+    perimeter[i] = g.missing[i] ? NA_REAL : sum_perimeter[i];
+  }
+
+  writable::data_frame out({
+    "area"_nm = area,
+    "perimeter"_nm = perimeter
+  });
+
+  return out;
+}
+
+// Length of the line strings of each feature
+[[cpp11::register]]
+cpp11::writable::doubles geometry_length_cpp(cpp11::list x, bool wkb, bool rhumb,
+                                             int nthreads) {
+  geometry_set g;
+  geometry_read(x, wkb, g);
+  vector<double> ring_area, ring_length;
+  if (rhumb)
+    geometry_measures(Rhumb::WGS84(), g, nthreads, ring_area, ring_length);
+  else
+    geometry_measures(Geodesic::WGS84(), g, nthreads, ring_area, ring_length);
+
+  size_t nn = g.nfeatures;
+  vector<double> sum_length(nn, 0.0);
+  for (size_t r = 0; r < g.rings.size(); r++)
+    if (g.rings[r].kind == GEOM_LINE)
+      sum_length[g.rings[r].feature] += ring_length[r];
+
+  writable::doubles length(nn);
+  for (size_t i = 0; i < nn; i++)
+    length[i] = g.missing[i] ? NA_REAL : sum_length[i];
+  return length;
+}
+
+// Densification ----------------------------------------------------------------
+
+// Append the points strictly between the ends of an edge, no more than
+// maxdist apart
+static void densify_edge(const Geodesic& geod, double lat1, double lon1,
+                         double lat2, double lon2, double maxdist,
+                         vector<double>& lat, vector<double>& lon) {
+  GeodesicLine l = geod.InverseLine(lat1, lon1, lat2, lon2);
+  double s13 = l.Distance();
+  if (!(s13 > maxdist)) return;
+  double m = ceil(s13 / maxdist);
+  for (double k = 1; k < m; k++) {
+    double la, lo;
+    l.Position(s13 * k / m, la, lo);
+    lat.push_back(la);
+    lon.push_back(lo);
+  }
+}
+
+static void densify_edge(const Rhumb& rh, double lat1, double lon1,
+                         double lat2, double lon2, double maxdist,
+                         vector<double>& lat, vector<double>& lon) {
+  double s13, azi;
+  rh.Inverse(lat1, lon1, lat2, lon2, s13, azi);
+  if (!(s13 > maxdist)) return;
+  RhumbLine l = rh.Line(lat1, lon1, azi);
+  double m = ceil(s13 / maxdist);
+  for (double k = 1; k < m; k++) {
+    double la, lo;
+    l.Position(s13 * k / m, la, lo);
+    lat.push_back(la);
+    lon.push_back(lo);
+  }
+}
+
+// The points of each block, with the ring each belongs to
+struct densify_block {
+  vector<double> lat, lon;
+  vector<size_t> ring;
+};
+
+template <class G>
+static void geometry_densify(const G& earth, const geometry_set& g, double maxdist,
+                             int nthreads, vector<densify_block>& out) {
+  vector<size_t> blocks = geometry_blocks(g);
+  out.assign(blocks.size() - 1, densify_block());
+  const geometry_ring* rings = g.rings.data();
+  const size_t* pblocks = blocks.data();
+  densify_block* pout = out.data();
+  geographiclib_r::parallel_tasks(blocks.size() - 1, nthreads, [&](size_t b) {
+    densify_block& o = pout[b];
+    for (size_t r = pblocks[b]; r < pblocks[b + 1]; r++) {
+      const geometry_ring& ring = rings[r];
+      for (size_t i = 0; i < ring.n; i++) {
+        double la = ring.lat(i), lo = ring.lon(i);
+        if (i > 0 && ring.kind != GEOM_POINT)
+          densify_edge(earth, o.lat.back(), o.lon.back(), la, lo, maxdist,
+                       o.lat, o.lon);
+        o.lat.push_back(la);
+        o.lon.push_back(lo);
+      }
+      o.ring.resize(o.lat.size(), r);
+    }
+  });
+}
+
+// Points of each feature with extra points so that no edge is longer than
+// distance, in the layout of sf::st_coordinates()
+[[cpp11::register]]
+cpp11::writable::data_frame geometry_densify_cpp(cpp11::list x, bool wkb,
+                                                 double distance, bool rhumb,
+                                                 int nthreads) {
+  geometry_set g;
+  geometry_read(x, wkb, g);
+  vector<densify_block> blocks;
+  if (rhumb)
+    geometry_densify(Rhumb::WGS84(), g, distance, nthreads, blocks);
+  else
+    geometry_densify(Geodesic::WGS84(), g, distance, nthreads, blocks);
+
+  size_t total = 0;
+  for (const densify_block& b : blocks) total += b.lat.size();
+  writable::doubles lon(total);
+  writable::doubles lat(total);
+  writable::integers id(total);
+  writable::integers part(total);
+  writable::integers ring(total);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  int* pid = INTEGER(id);
+  int* ppart = INTEGER(part);
+  int* pring = INTEGER(ring);
+  size_t k = 0;
+  for (const densify_block& b : blocks) {
+    for (size_t i = 0; i < b.lat.size(); i++, k++) {
+      const geometry_ring& r = g.rings[b.ring[i]];
+      plon[k] = b.lon[i];
+      plat[k] = b.lat[i];
+      pid[k] = static_cast<int>(r.feature + 1);
+      ppart[k] = r.part + 1;
+      pring[k] = r.ring + 1;
+    }
+  }
+
+  writable::data_frame out({
+    "lon"_nm = lon,
+    "lat"_nm = lat,
+    "id"_nm = id,
+    "part"_nm = part,
+    "ring"_nm = ring
+  });
+
+  return out;
+}
@@ -25,15 +25,9 @@ cpp11::writable::data_frame gnomonic_fwd_cpp(cpp11::doubles lon, cpp11::doubles
   const Geodesic& geod = Geodesic::WGS84();
   Gnomonic gn(geod);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, azz, rkk;
-    gn.Forward(lat0, lon0, lat[i], lon[i], xx, yy, azz, rkk);
-    
-    x[i] = xx;
-    y[i] = yy;
-    azi[i] = azz;
-    rk[i] = rkk;
-  }
+  // The center is fixed, so it is set up once for all points
+  gn.Forward(lat0, lon0, REAL(lat), REAL(lon), nn,
+             REAL(x), REAL(y), REAL(azi), REAL(rk));
   
   writable::data_frame out({
     "x"_nm = x,
@@ -2,9 +2,14 @@
 using namespace cpp11;
 namespace writable = cpp11::writable;
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 #include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
 #include <GeographicLib/Intersect.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_segindex_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -257,3 +262,176 @@ cpp11::writable::list intersect_all_cpp(
   
   return out;
 }
+
+// Segments of polylines: consecutive rows with the same id (all one line if
+// id is null), skipping rows with missing coordinates and repeated vertices
+struct polyline_segments {
+  vector<size_t> a, b;           // First and second row of each segment
+  vector<double> length;         // Length of each segment (meters)
+  vector<geographiclib_r::segment_box> boxes;  // Boxes of segment k are
+  vector<size_t> box_start;                    //   box_start[k] .. [k + 1]
+};
+
+static void polyline_segments_build(const Geodesic& geod, const double* lat,
+                                    const double* lon, const int* id, size_t n,
+                                    int nthreads, polyline_segments& s) {
+  for (size_t i = 0; i + 1 < n; i++) {
+    if (id && id[i] != id[i + 1]) continue;
+    if (ISNAN(lat[i]) || ISNAN(lon[i]) || ISNAN(lat[i + 1]) || ISNAN(lon[i + 1]))
+      continue;
+    if (lat[i] == lat[i + 1] && lon[i] == lon[i + 1]) continue;
+    s.a.push_back(i);
+    s.b.push_back(i + 1);
+  }
+  size_t nseg = s.a.size();
+  geographiclib_r::segment_boxes(geod, lat, lon, s.a.data(), s.b.data(),
+                                 nseg, nthreads, s.boxes, s.length);
+  s.box_start.assign(nseg + 1, 0);
+  for (const auto& q : s.boxes) s.box_start[q.seg + 1]++;
+  for (size_t k = 0; k < nseg; k++) s.box_start[k + 1] += s.box_start[k];
+}
+
+// A crossing of segment kx of X and ky of Y, at x and y meters along them
+struct polyline_crossing {
+  size_t kx, ky;
+  double x, y, lat, lon;
+  int coincidence;
+};
+
+// Crossings of two sets of polylines.  Each segment of X is tested only
+// against the segments of Y whose boxes overlap its own.  A crossing within
+// tol of the end of a segment counts (rounding can put a crossing at a
+// vertex just outside both segments that share it), and a crossing at a
+// vertex shared by consecutive segments is kept once, on the earlier one.
+static void polyline_crossings(const Geodesic& geod,
+                               const double* platX, const double* plonX,
+                               const int* idX, size_t nX,
+                               const double* platY, const double* plonY,
+                               const int* idY, size_t nY, int nthreads,
+                               polyline_segments& sx, polyline_segments& sy,
+                               vector<polyline_crossing>& all) {
+  polyline_segments_build(geod, platX, plonX, idX, nX, nthreads, sx);
+  polyline_segments_build(geod, platY, plonY, idY, nY, nthreads, sy);
+  size_t nx = sx.a.size(), ny = sy.a.size();
+  // Y is indexed; its boxes move into the index
+  geographiclib_r::segment_index yindex;
+  yindex.build(sy.boxes);
+
+  const double tol = 1e-3;      // meters
+
+  // Blocks of X segments, each with its own list of crossings
+  const size_t block = 256;
+  size_t nblocks = (nx + block - 1) / block;
+  vector<vector<polyline_crossing>> found(nblocks);
+
+  const polyline_segments* px = &sx;
+  const polyline_segments* py = &sy;
+  const geographiclib_r::segment_index* pindex = &yindex;
+  vector<polyline_crossing>* pfound = found.data();
+  geographiclib_r::parallel_tasks(nblocks, nthreads, [&](size_t t) {
+    Intersect inter(geod);
+    vector<size_t> cand;
+    vector<polyline_crossing>& out = pfound[t];
+    for (size_t kx = t * block; kx < min(nx, (t + 1) * block); kx++) {
+      size_t a = px->a[kx], b = px->b[kx];
+      GeodesicLine lineX = geod.InverseLine(platX[a], plonX[a], platX[b], plonX[b],
+                                            Intersect::LineCaps);
+      cand.clear();
+      for (size_t j = px->box_start[kx]; j < px->box_start[kx + 1]; j++)
+        pindex->query(px->boxes[j], [&](size_t ky) { cand.push_back(ky); });
+      sort(cand.begin(), cand.end());
+      cand.erase(unique(cand.begin(), cand.end()), cand.end());
+      size_t first = out.size();
+      for (size_t ky : cand) {
+        size_t c = py->a[ky], d = py->b[ky];
+        GeodesicLine lineY = geod.InverseLine(platY[c], plonY[c], platY[d], plonY[d],
+                                              Intersect::LineCaps);
+        int segmode, coinc;
+        Intersect::Point p = inter.Segment(lineX, lineY, segmode, &coinc);
+        if (segmode != 0) {
+          double sx1 = px->length[kx], sy1 = py->length[ky];
+          if (!(p.first >= -tol && p.first <= sx1 + tol &&
+                p.second >= -tol && p.second <= sy1 + tol))
+            continue;
+          p.first = min(max(p.first, 0.0), sx1);
+          p.second = min(max(p.second, 0.0), sy1);
+        }
+        polyline_crossing h{kx, ky, p.first, p.second, 0, 0, coinc};
+        lineX.Position(p.first, h.lat, h.lon);
+        out.push_back(h);
+      }
+      // In order along the X segment
+      sort(out.begin() + first, out.end(),
+           [](const polyline_crossing& u, const polyline_crossing& v) {
+             return u.x < v.x || (u.x == v.x && u.ky < v.ky);
+           });
+    }
+  });
+
+  // Drop the second report of a crossing at a vertex shared by consecutive
+  // segments (of X or of Y), which both segments find
+  vector<polyline_crossing> hits;
+  for (size_t t = 0; t < nblocks; t++)
+    hits.insert(hits.end(), found[t].begin(), found[t].end());
+  unordered_map<size_t, size_t> where;  // kx * ny + ky -> hit
+  for (size_t h = 0; h < hits.size(); h++)
+    where.emplace(hits[h].kx * ny + hits[h].ky, h);
+  auto at = [&](size_t kx, size_t ky) -> const polyline_crossing* {
+    auto it = where.find(kx * ny + ky);
+    return it == where.end() ? nullptr : &hits[it->second];
+  };
+  all.clear();
+  for (const polyline_crossing& h : hits) {
+    if (h.y <= tol && h.ky > 0 && sy.b[h.ky - 1] == sy.a[h.ky]) {
+      const polyline_crossing* q = at(h.kx, h.ky - 1);
+      if (q && q->y >= sy.length[h.ky - 1] - tol) continue;
+    }
+    if (h.x <= tol && h.kx > 0 && sx.b[h.kx - 1] == sx.a[h.kx]) {
+      const polyline_crossing* q = at(h.kx - 1, h.ky);
+      if (q && q->x >= sx.length[h.kx - 1] - tol) continue;
+    }
+    all.push_back(h);
+  }
+}
+
+// Crossings of the polylines of X with those of Y
+[[cpp11::register]]
+cpp11::writable::data_frame intersect_polylines_cpp(
+    cpp11::doubles latX, cpp11::doubles lonX, cpp11::integers idX,
+    cpp11::doubles latY, cpp11::doubles lonY, cpp11::integers idY,
+    int nthreads) {
+
+  polyline_segments sx, sy;
+  vector<polyline_crossing> all;
+  polyline_crossings(Geodesic::WGS84(), REAL(latX), REAL(lonX),
+                     idX.size() > 0 ? INTEGER(idX) : nullptr, latX.size(),
+                     REAL(latY), REAL(lonY),
+                     idY.size() > 0 ? INTEGER(idY) : nullptr, latY.size(),
+                     nthreads, sx, sy, all);
+
+  size_t nn = all.size();
+  writable::integers x_segment(nn), y_segment(nn), c(nn);
+  writable::doubles x(nn), y(nn), lat(nn), lon(nn);
+  for (size_t i = 0; i < nn; i++) {
+    const polyline_crossing& h = all[i];
+    x_segment[i] = static_cast<int>(sx.a[h.kx] + 1);
+    y_segment[i] = static_cast<int>(sy.a[h.ky] + 1);
+    x[i] = h.x;
+    y[i] = h.y;
+    c[i] = h.coincidence;
+    lat[i] = h.lat;
+    lon[i] = h.lon;
+  }
+
+  writable::data_frame out({
+    "x_segment"_nm = x_segment,
+    "y_segment"_nm = y_segment,
+    "x"_nm = x,
+    "y"_nm = y,
+    "coincidence"_nm = c,
+    "lat"_nm = lat,
+    "lon"_nm = lon
+  });
+
+  return out;
+}
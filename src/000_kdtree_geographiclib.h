@@ -0,0 +1,239 @@
+#ifndef GEOGRAPHICLIB_R_KDTREE_H
+#define GEOGRAPHICLIB_R_KDTREE_H
+
+// Nearest neighbor index on geocentric (ECEF) coordinates.
+//
+// The points are converted once with Geocentric::Forward and stored in a
+// 3-D kd-tree laid out implicitly in a flat array: the node for the range
+// [l, u) is the median element m = l + (u - l) / 2, its children cover
+// [l, m) and [m + 1, u), and ranges of at most `leaf` points are scanned.
+//
+// The straight-line (chord) distance between two points never exceeds the
+// geodesic distance between them, so
+//   * a radius search only needs the points within that chord distance;
+//   * if the k points nearest by chord are at most S away along geodesics,
+//     the k geodesic nearest neighbors are all within chord distance S.
+// Candidates are found with cheap chord distances and only they are passed
+// to Geodesic::Inverse, so the results are exact geodesic neighbors.
+//
+// All searches are const and may run on several threads at once.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/Geodesic.hpp>
+
+namespace geographiclib_r {
+
+class ecef_kdtree {
+public:
+  // Build the tree from n points; points with non-finite coordinates are
+  // left out (they are never anyone's neighbor)
+  void build(const double* lat, const double* lon, size_t n) {
+    const GeographicLib::Geocentric& earth = GeographicLib::Geocentric::WGS84();
+    _pts.clear();
+    _pts.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      if (!(std::isfinite(lat[i]) && std::isfinite(lon[i]))) continue;
+      node p;
+      earth.Forward(lat[i], lon[i], 0, p.x[0], p.x[1], p.x[2]);
+      p.lat = lat[i];
+      p.lon = lon[i];
+      p.id = static_cast<int>(i);
+      _pts.push_back(p);
+    }
+    _dim.assign(_pts.size(), 0);
+    split(0, _pts.size());
+    _n = n;
+  }
+
+  // Number of points the tree was built from (including any left out)
+  size_t size() const { return _n; }
+
+  // The k nearest neighbors of (lat, lon) by geodesic distance, closest
+  // first.  ind receives 0-based point indices and dist the distances.
+  void knn(double lat, double lon, int k,
+           std::vector<int>& ind, std::vector<double>& dist) const {
+    ind.clear();
+    dist.clear();
+    size_t kk = std::min(static_cast<size_t>(std::max(k, 0)), _pts.size());
+    if (kk == 0) return;
+    double q[3];
+    GeographicLib::Geocentric::WGS84().Forward(lat, lon, 0, q[0], q[1], q[2]);
+    const GeographicLib::Geodesic::InverseOrigin org =
+      GeographicLib::Geodesic::WGS84().InverseFrom(lat, lon);
+
+    // The kk nearest points by chord give an upper bound on the kk'th
+    // geodesic distance
+    std::priority_queue<std::pair<double, size_t>> heap;
+    knn_chord(0, _pts.size(), q, kk, heap);
+    std::vector<std::pair<size_t, double>> first;
+    first.reserve(kk);
+    double bound = 0;
+    for (; !heap.empty(); heap.pop()) {
+      size_t j = heap.top().second;
+      double s;
+      org.Inverse(_pts[j].lat, _pts[j].lon, s);
+      first.emplace_back(j, s);
+      bound = std::max(bound, s);
+    }
+    std::sort(first.begin(), first.end());
+
+    // Every point closer than that along a geodesic is within that chord
+    // distance; rank them all exactly, reusing the distances found above
+    std::vector<size_t> cand;
+    radius_chord(0, _pts.size(), q, sq(widen(bound)), cand);
+    std::vector<std::pair<double, int>> ranked;
+    ranked.reserve(cand.size());
+    for (size_t j : cand) {
+      auto it = std::lower_bound(first.begin(), first.end(),
+                                 std::make_pair(j, -1.0));
+      double s;
+      if (it != first.end() && it->first == j)
+        s = it->second;
+      else
+        org.Inverse(_pts[j].lat, _pts[j].lon, s);
+      ranked.emplace_back(s, _pts[j].id);
+    }
+    kk = std::min(kk, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + kk, ranked.end());
+    for (size_t i = 0; i < kk; i++) {
+      dist.push_back(ranked[i].first);
+      ind.push_back(ranked[i].second);
+    }
+  }
+
+  // All points within geodesic distance r of (lat, lon), closest first
+  void radius(double lat, double lon, double r,
+              std::vector<int>& ind, std::vector<double>& dist) const {
+    ind.clear();
+    dist.clear();
+    if (_pts.empty() || !(r >= 0)) return;
+    double q[3];
+    GeographicLib::Geocentric::WGS84().Forward(lat, lon, 0, q[0], q[1], q[2]);
+    const GeographicLib::Geodesic::InverseOrigin org =
+      GeographicLib::Geodesic::WGS84().InverseFrom(lat, lon);
+
+    std::vector<size_t> cand;
+    radius_chord(0, _pts.size(), q, sq(widen(r)), cand);
+    std::vector<std::pair<double, int>> found;
+    for (size_t j : cand) {
+      double s;
+      org.Inverse(_pts[j].lat, _pts[j].lon, s);
+      if (s <= r) found.emplace_back(s, _pts[j].id);
+    }
+    std::sort(found.begin(), found.end());
+    for (const auto& f : found) {
+      dist.push_back(f.first);
+      ind.push_back(f.second);
+    }
+  }
+
+private:
+  struct node {
+    double x[3];                // geocentric coordinates (meters)
+    double lat, lon;
+    int id;                     // index into the original points
+  };
+  static const size_t leaf = 8;
+
+  std::vector<node> _pts;       // in tree order
+  std::vector<unsigned char> _dim;  // split axis of each interior node
+  size_t _n = 0;
+
+  static double sq(double x) { return x * x; }
+
+  // Allow for roundoff in the geocentric coordinates and the geodesic
+  // distance when turning a geodesic distance into a chord bound
+  static double widen(double s) { return s * (1 + 1e-12) + 1e-6; }
+
+  static double dist2(const node& p, const double q[3]) {
+    return sq(p.x[0] - q[0]) + sq(p.x[1] - q[1]) + sq(p.x[2] - q[2]);
+  }
+
+  // Order [l, u) around its median on the axis of greatest extent
+  void split(size_t l, size_t u) {
+    while (u - l > leaf) {
+      double lo[3], hi[3];
+      for (int d = 0; d < 3; d++) lo[d] = hi[d] = _pts[l].x[d];
+      for (size_t i = l + 1; i < u; i++) {
+        for (int d = 0; d < 3; d++) {
+          lo[d] = std::min(lo[d], _pts[i].x[d]);
+          hi[d] = std::max(hi[d], _pts[i].x[d]);
+        }
+      }
+      int d = 0;
+      for (int e = 1; e < 3; e++)
+        if (hi[e] - lo[e] > hi[d] - lo[d]) d = e;
+      size_t m = l + (u - l) / 2;
+      std::nth_element(_pts.begin() + l, _pts.begin() + m, _pts.begin() + u,
+                       [d](const node& a, const node& b) {
+                         return a.x[d] < b.x[d];
+                       });
+      _dim[m] = static_cast<unsigned char>(d);
+      split(l, m);
+      l = m + 1;
+    }
+  }
+
+  // The k nearest by chord, as a max-heap of (squared chord, tree position)
+  void knn_chord(size_t l, size_t u, const double q[3], size_t k,
+                 std::priority_queue<std::pair<double, size_t>>& heap) const {
+    auto visit = [&](size_t i) {
+      double d2 = dist2(_pts[i], q);
+      if (heap.size() < k) {
+        heap.emplace(d2, i);
+      } else if (d2 < heap.top().first) {
+        heap.pop();
+        heap.emplace(d2, i);
+      }
+    };
+    if (u - l <= leaf) {
+      for (size_t i = l; i < u; i++) visit(i);
+      return;
+    }
+    size_t m = l + (u - l) / 2;
+    int d = _dim[m];
+    visit(m);
+    double diff = q[d] - _pts[m].x[d];
+    if (diff < 0) {
+      knn_chord(l, m, q, k, heap);
+      if (heap.size() < k || sq(diff) < heap.top().first)
+        knn_chord(m + 1, u, q, k, heap);
+    } else {
+      knn_chord(m + 1, u, q, k, heap);
+      if (heap.size() < k || sq(diff) < heap.top().first)
+        knn_chord(l, m, q, k, heap);
+    }
+  }
+
+  // Tree positions of all points within squared chord distance r2
+  void radius_chord(size_t l, size_t u, const double q[3], double r2,
+                    std::vector<size_t>& out) const {
+    while (u - l > leaf) {
+      size_t m = l + (u - l) / 2;
+      int d = _dim[m];
+      if (dist2(_pts[m], q) <= r2) out.push_back(m);
+      double diff = q[d] - _pts[m].x[d];
+      if (diff < 0) {
+        radius_chord(l, m, q, r2, out);
+        if (sq(diff) > r2) return;
+        l = m + 1;
+      } else {
+        radius_chord(m + 1, u, q, r2, out);
+        if (sq(diff) > r2) return;
+        u = m;
+      }
+    }
+    for (size_t i = l; i < u; i++)
+      if (dist2(_pts[i], q) <= r2) out.push_back(i);
+  }
+};
+
+} // namespace geographiclib_r
+
+#endif // GEOGRAPHICLIB_R_KDTREE_H
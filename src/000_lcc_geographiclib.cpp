@@ -4,6 +4,7 @@ namespace writable = cpp11::writable;
 
 #include <GeographicLib/LambertConformalConic.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -13,7 +14,7 @@ using namespace GeographicLib;
 [[cpp11::register]]
 cpp11::writable::data_frame lcc_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
                                          double lon0, double lat0, double stdlat,
-                                         double k0) {
+                                         double k0, int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -25,15 +26,23 @@ cpp11::writable::data_frame lcc_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
   const LambertConformalConic lcc(Constants::WGS84_a(), Constants::WGS84_f(), 
                                    stdlat, k0);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    lcc.Forward(lon0, lat[i], lon[i], xx, yy, gamma, k);
-    
-    x[i] = xx;
-    y[i] = yy;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      lcc.Forward(lon0, plat[i], plon[i], xx, yy, gamma, k);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -53,7 +62,7 @@ cpp11::writable::data_frame lcc_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
 cpp11::writable::data_frame lcc_fwd2_cpp(cpp11::doubles lon, cpp11::doubles lat,
                                           double lon0, double lat0, 
                                           double stdlat1, double stdlat2,
-                                          double k1) {
+                                          double k1, int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -65,15 +74,23 @@ cpp11::writable::data_frame lcc_fwd2_cpp(cpp11::doubles lon, cpp11::doubles lat,
   const LambertConformalConic lcc(Constants::WGS84_a(), Constants::WGS84_f(), 
                                    stdlat1, stdlat2, k1);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    lcc.Forward(lon0, lat[i], lon[i], xx, yy, gamma, k);
-    
-    x[i] = xx;
-    y[i] = yy;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      lcc.Forward(lon0, plat[i], plon[i], xx, yy, gamma, k);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -92,7 +109,7 @@ cpp11::writable::data_frame lcc_fwd2_cpp(cpp11::doubles lon, cpp11::doubles lat,
 [[cpp11::register]]
 cpp11::writable::data_frame lcc_rev_cpp(cpp11::doubles x, cpp11::doubles y,
                                          double lon0, double lat0, double stdlat,
-                                         double k0) {
+                                         double k0, int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -104,15 +121,23 @@ cpp11::writable::data_frame lcc_rev_cpp(cpp11::doubles x, cpp11::doubles y,
   const LambertConformalConic lcc(Constants::WGS84_a(), Constants::WGS84_f(), 
                                    stdlat, k0);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    lcc.Reverse(lon0, x[i], y[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      lcc.Reverse(lon0, px[i], py[i], la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
@@ -132,7 +157,7 @@ cpp11::writable::data_frame lcc_rev_cpp(cpp11::doubles x, cpp11::doubles y,
 cpp11::writable::data_frame lcc_rev2_cpp(cpp11::doubles x, cpp11::doubles y,
                                           double lon0, double lat0,
                                           double stdlat1, double stdlat2,
-                                          double k1) {
+                                          double k1, int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -144,15 +169,23 @@ cpp11::writable::data_frame lcc_rev2_cpp(cpp11::doubles x, cpp11::doubles y,
   const LambertConformalConic lcc(Constants::WGS84_a(), Constants::WGS84_f(), 
                                    stdlat1, stdlat2, k1);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    lcc.Reverse(lon0, x[i], y[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      lcc.Reverse(lon0, px[i], py[i], la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
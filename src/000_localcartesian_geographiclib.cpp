@@ -5,6 +5,7 @@ namespace writable = cpp11::writable;
 #include <GeographicLib/LocalCartesian.hpp>
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -14,7 +15,8 @@ using namespace GeographicLib;
 [[cpp11::register]]
 cpp11::writable::data_frame localcartesian_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, 
                                                     cpp11::doubles h,
-                                                    double lon0, double lat0, double h0) {
+                                                    double lon0, double lat0, double h0,
+                                                    int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -25,14 +27,15 @@ cpp11::writable::data_frame localcartesian_fwd_cpp(cpp11::doubles lon, cpp11::do
   const Geocentric& earth = Geocentric::WGS84();
   LocalCartesian lc(lat0, lon0, h0, earth);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, zz;
-    lc.Forward(lat[i], lon[i], h[i], xx, yy, zz);
-    
-    x[i] = xx;
-    y[i] = yy;
-    z[i] = zz;
-  }
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  const double* ph = REAL(h);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pz = REAL(z);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    lc.Forward(plat + i0, plon + i0, ph + i0, i1 - i0, px + i0, py + i0, pz + i0);
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -50,7 +53,8 @@ cpp11::writable::data_frame localcartesian_fwd_cpp(cpp11::doubles lon, cpp11::do
 [[cpp11::register]]
 cpp11::writable::data_frame localcartesian_rev_cpp(cpp11::doubles x, cpp11::doubles y, 
                                                     cpp11::doubles z,
-                                                    double lon0, double lat0, double h0) {
+                                                    double lon0, double lat0, double h0,
+                                                    int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -60,14 +64,15 @@ cpp11::writable::data_frame localcartesian_rev_cpp(cpp11::doubles x, cpp11::doub
   const Geocentric& earth = Geocentric::WGS84();
   LocalCartesian lc(lat0, lon0, h0, earth);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, hh;
-    lc.Reverse(x[i], y[i], z[i], la, lo, hh);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    h[i] = hh;
-  }
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  const double* pz = REAL(z);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* ph = REAL(h);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    lc.Reverse(px + i0, py + i0, pz + i0, i1 - i0, plat + i0, plon + i0, ph + i0);
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
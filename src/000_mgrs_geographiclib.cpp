@@ -3,12 +3,21 @@ using namespace cpp11;
 namespace writable = cpp11::writable;
 
 //// https://geographiclib.sourceforge.io/C++/doc/classGeographicLib_1_1MGRS.html
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <GeographicLib/UTMUPS.hpp>
 #include <GeographicLib/MGRS.hpp>
+#include "000_parallel_geographiclib.h"
+#include "000_utmups_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
+using geographiclib_r::utmups_crs_column;
+using geographiclib_r::utmups_key;
+using geographiclib_r::utmups_wants;
 
 
 string mgrs_fwd0(double lon, double lat, int precision) {
@@ -22,95 +31,210 @@ string mgrs_fwd0(double lon, double lat, int precision) {
   MGRS::Forward(zone, northp, x, y, lat, precision, mgrs);
   return mgrs;
 }
+// Forward: Geographic (lon/lat) to MGRS
+//
+// Blocks of points are encoded on several threads into one reusable
+// character buffer, with no std::string per point, and the R strings are
+// made from the buffer on the main thread.
 [[cpp11::register]]
-cpp11::strings mgrs_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers precision) {
+cpp11::writable::strings mgrs_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
+                                      cpp11::integers precision, int nthreads) {
   size_t nn = lon.size();
-  int zone;
-  bool northp;
-  double x, y;
-  string mgrs;
+  const size_t nblock = 65536;
+  const int width = MGRS::maxmgrslen_;
+
   writable::strings out(nn);
-  for (size_t i = 0; i < nn; i++) {
-   UTMUPS::Forward(lat[i], lon[i], zone, northp, x, y);
-    MGRS::Forward(zone, northp, x, y, lat[i], precision[i], mgrs);
-    out[i] = mgrs;
+  vector<char> buf(min(nn, nblock) * width);
+  vector<int> len(min(nn, nblock));
+
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  const int* pprecision = INTEGER(precision);
+  char* pbuf = buf.data();
+  int* plen = len.data();
+  for (size_t b0 = 0; b0 < nn; b0 += nblock) {
+    size_t m = min(nblock, nn - b0);
+    geographiclib_r::parallel_for(m, nthreads, [&](size_t i0, size_t i1) {
+      for (size_t i = i0; i < i1; i++) {
+        int zone;
+        bool northp;
+        double x, y, la = plat[b0 + i];
+        UTMUPS::Forward(la, plon[b0 + i], zone, northp, x, y);
+        plen[i] = MGRS::Forward(zone, northp, x, y, la, pprecision[b0 + i],
+                                pbuf + i * width);
+      }
+    });
+    for (size_t i = 0; i < m; i++)
+      SET_STRING_ELT(out, b0 + i, Rf_mkCharLen(pbuf + i * width, plen[i]));
   }
- return out;
+
+  return out;
+}
+
+// The grid zone designation and 100 km block of a parsed reference, packed
+// with their lengths into one key.  They are at most 3 and 2 characters.
+static uint64_t mgrs_prefix_key(const char* str, int gzdlen, int blocklen) {
+  uint64_t key = uint64_t(gzdlen) << 48 | uint64_t(blocklen) << 56;
+  for (int k = 0; k < gzdlen + blocklen; k++)
+    key |= uint64_t((unsigned char)(str[k])) << (8 * k);
+  return key;
 }
 
+// A label column (grid zone or 100 km block) for the rows with the given
+// prefix ids, from one label per distinct prefix.  type is "string" or
+// "factor" (levels sorted, an empty label is NA).
+static SEXP mgrs_label_column(const vector<int>& id, const vector<string>& label,
+                              const string& type) {
+  size_t nn = id.size(), np = label.size();
+  if (type == "factor") {
+    vector<string> levels(label);
+    sort(levels.begin(), levels.end());
+    levels.erase(unique(levels.begin(), levels.end()), levels.end());
+    levels.erase(remove(levels.begin(), levels.end(), string()), levels.end());
+    vector<int> code(np);
+    for (size_t e = 0; e < np; e++) {
+      auto it = lower_bound(levels.begin(), levels.end(), label[e]);
+      code[e] = it != levels.end() && *it == label[e] ?
+        int(it - levels.begin()) + 1 : NA_INTEGER;
+    }
+    writable::integers out(nn);
+    int* pout = INTEGER(out);
+    for (size_t i = 0; i < nn; i++) pout[i] = id[i] < 0 ? NA_INTEGER : code[id[i]];
+    writable::strings lev(levels.size());
+    for (size_t l = 0; l < levels.size(); l++) lev[l] = levels[l];
+    out.attr("levels") = lev;
+    out.attr("class") = "factor";
+    return out;
+  }
+  if (type != "string") cpp11::stop("unknown designator type '%s'", type.c_str());
+  vector<r_string> str(label.begin(), label.end());
+  writable::strings out(nn);
+  for (size_t i = 0; i < nn; i++)
+    SET_STRING_ELT(out, i, id[i] < 0 ? NA_STRING : SEXP(str[id[i]]));
+  return out;
+}
+
+// Reverse: MGRS to Geographic (lon/lat) and UTM/UPS
+//
+// Each reference is parsed once, by MGRS::Reverse on its characters, which
+// also gives the split into grid zone and 100 km block.  References come in
+// clusters sharing these, so the label and CRS columns are made once per
+// distinct prefix (or zone) and shared by its rows.  Missing strings give
+// missing rows.  Only the columns named in `columns` are returned.
 [[cpp11::register]]
-cpp11::writable::data_frame mgrs_rev_cpp(cpp11::strings mgrs) {
+cpp11::writable::data_frame mgrs_rev_cpp(cpp11::strings mgrs, cpp11::strings columns,
+                                         std::string crs, std::string designators,
+                                         int nthreads) {
   size_t nn = mgrs.size();
-  
-  writable::doubles lon(nn);
-  writable::doubles lat(nn);
-  writable::doubles x(nn);
-  writable::doubles y(nn);
-  writable::integers zone(nn);
-  writable::logicals northp(nn);
-  writable::integers precision(nn);
-  writable::doubles convergence(nn);
-  writable::doubles scale(nn);
-  writable::strings grid_zone(nn);
-  writable::strings square_100km(nn);
-  writable::strings crs(nn);
-  
+  bool want_lon = utmups_wants(columns, "lon"), want_lat = utmups_wants(columns, "lat");
+  bool want_x = utmups_wants(columns, "x"), want_y = utmups_wants(columns, "y");
+  bool want_zone = utmups_wants(columns, "zone");
+  bool want_northp = utmups_wants(columns, "northp");
+  bool want_prec = utmups_wants(columns, "precision");
+  bool want_gamma = utmups_wants(columns, "convergence");
+  bool want_k = utmups_wants(columns, "scale");
+  bool want_geo = want_lon || want_lat || want_gamma || want_k;
+
+  writable::doubles lon(want_lon ? nn : 0);
+  writable::doubles lat(want_lat ? nn : 0);
+  writable::doubles x(want_x ? nn : 0);
+  writable::doubles y(want_y ? nn : 0);
+  writable::integers zone(want_zone ? nn : 0);
+  writable::logicals northp(want_northp ? nn : 0);
+  writable::integers precision(want_prec ? nn : 0);
+  writable::doubles convergence(want_gamma ? nn : 0);
+  writable::doubles scale(want_k ? nn : 0);
+  vector<const char*> str(nn, nullptr);
+  vector<int> len(nn, 0), key(nn), gzdlen(nn), blocklen(nn);
+
   for (size_t i = 0; i < nn; i++) {
-    int z, prec;
-    bool np;
-    double xx, yy, la, lo, gamma, k;
-    string gridzone, block, easting, northing;
-    
-    // Reverse MGRS to UTM/UPS coordinates
-    MGRS::Reverse(mgrs[i], z, np, xx, yy, prec);
-    
-    // Decode MGRS components
-    MGRS::Decode(mgrs[i], gridzone, block, easting, northing);
-    
-    // Reverse to geographic with convergence and scale
-    UTMUPS::Reverse(z, np, xx, yy, la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    x[i] = xx;
-    y[i] = yy;
-    zone[i] = z;
-    northp[i] = np;
-    precision[i] = prec;
-    convergence[i] = gamma;
-    scale[i] = k;
-    grid_zone[i] = gridzone;
-    square_100km[i] = block;
-    
-    // Build CRS string
-    string crs_str;
-    if (z == 0) {
-      // Polar zones: UPS North (32661) or UPS South (32761)
-      crs_str = np ? "EPSG:32661" : "EPSG:32761";
-    } else {
-      // Standard UTM zones: EPSG:326XX (north) or EPSG:327XX (south)
-      int hemi_code = np ? 6 : 7;
-      crs_str = "EPSG:32" + to_string(hemi_code) + (z < 10 ? "0" : "") + to_string(z);
-    }
-    crs[i] = crs_str;
+    SEXP s = STRING_ELT(mgrs, i);
+    if (s == NA_STRING) continue;
+    str[i] = CHAR(s);
+    len[i] = LENGTH(s);
   }
-  
-  writable::data_frame out({
-    "lon"_nm = lon,
-    "lat"_nm = lat,
-    "x"_nm = x,
-    "y"_nm = y,
-    "zone"_nm = zone,
-    "northp"_nm = northp,
-    "precision"_nm = precision,
-    "convergence"_nm = convergence,
-    "scale"_nm = scale,
-    "grid_zone"_nm = grid_zone,
-    "square_100km"_nm = square_100km,
-    "crs"_nm = crs
+
+  const char* const* pstr = str.data();
+  const int* plen = len.data();
+  double* plon = want_lon ? REAL(lon) : nullptr;
+  double* plat = want_lat ? REAL(lat) : nullptr;
+  double* px = want_x ? REAL(x) : nullptr;
+  double* py = want_y ? REAL(y) : nullptr;
+  int* pzone = want_zone ? INTEGER(zone) : nullptr;
+  int* pnorthp = want_northp ? LOGICAL(northp) : nullptr;
+  int* pprec = want_prec ? INTEGER(precision) : nullptr;
+  double* pconvergence = want_gamma ? REAL(convergence) : nullptr;
+  double* pscale = want_k ? REAL(scale) : nullptr;
+  int* pkey = key.data();
+  int* pgzdlen = gzdlen.data();
+  int* pblocklen = blocklen.data();
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      int z = UTMUPS::INVALID, prec = NA_INTEGER, g = -1;
+      bool np = false;
+      double xx = Math::NaN(), yy = Math::NaN();
+      if (pstr[i]) MGRS::Reverse(pstr[i], plen[i], z, np, xx, yy, prec, g);
+      bool valid = z != UTMUPS::INVALID;
+
+      if (want_geo) {
+        double la, lo, gamma, k;
+        UTMUPS::Reverse(z, np, xx, yy, la, lo, gamma, k);
+        if (plon) plon[i] = lo;
+        if (plat) plat[i] = la;
+        if (pconvergence) pconvergence[i] = gamma;
+        if (pscale) pscale[i] = k;
+      }
+      if (px) px[i] = xx;
+      if (py) py[i] = yy;
+      if (pzone) pzone[i] = valid ? z : NA_INTEGER;
+      if (pnorthp) pnorthp[i] = valid ? (np ? TRUE : FALSE) : NA_LOGICAL;
+      if (pprec) pprec[i] = prec;
+      pkey[i] = utmups_key(z, np);
+      pgzdlen[i] = g;
+      pblocklen[i] = prec >= 0 ? 2 : 0;
+    }
   });
-  
-  return out;
+
+  writable::list out;
+  if (want_lon) out.push_back("lon"_nm = lon);
+  if (want_lat) out.push_back("lat"_nm = lat);
+  if (want_x) out.push_back("x"_nm = x);
+  if (want_y) out.push_back("y"_nm = y);
+  if (want_zone) out.push_back("zone"_nm = zone);
+  if (want_northp) out.push_back("northp"_nm = northp);
+  if (want_prec) out.push_back("precision"_nm = precision);
+  if (want_gamma) out.push_back("convergence"_nm = convergence);
+  if (want_k) out.push_back("scale"_nm = scale);
+
+  bool want_gzd = utmups_wants(columns, "grid_zone");
+  bool want_block = utmups_wants(columns, "square_100km");
+  if (want_gzd || want_block) {
+    // Number the distinct prefixes; runs of one prefix skip the hash lookup
+    vector<int> id(nn, -1);
+    vector<string> gzd_label, block_label;
+    unordered_map<uint64_t, int> ids;
+    uint64_t last = 0;
+    int lastid = -1;
+    for (size_t i = 0; i < nn; i++) {
+      if (gzdlen[i] < 0) continue;
+      uint64_t k = mgrs_prefix_key(str[i], gzdlen[i], blocklen[i]);
+      if (lastid < 0 || k != last) {
+        auto ins = ids.emplace(k, int(gzd_label.size()));
+        if (ins.second) {
+          gzd_label.emplace_back(str[i], gzdlen[i]);
+          block_label.emplace_back(str[i] + gzdlen[i], blocklen[i]);
+        }
+        last = k;
+        lastid = ins.first->second;
+      }
+      id[i] = lastid;
+    }
+    if (want_gzd) out.push_back("grid_zone"_nm = mgrs_label_column(id, gzd_label, designators));
+    if (want_block) out.push_back("square_100km"_nm = mgrs_label_column(id, block_label, designators));
+  }
+  if (utmups_wants(columns, "crs")) out.push_back("crs"_nm = utmups_crs_column(key, crs));
+
+  return writable::data_frame(out);
 }
 
 
@@ -4,9 +4,16 @@ namespace writable = cpp11::writable;
 
 #include <vector>
 #include <utility>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <limits>
+#include <cmath>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/NearestNeighbor.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
+#include "000_kdtree_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -14,7 +21,8 @@ using namespace GeographicLib;
 // Position type: lat, lon pair
 typedef pair<double, double> pos_t;
 
-// Distance functor for geodesic distances
+// Distance functor for geodesic distances (const, so it may be shared by
+// worker threads)
 class GeodesicDist {
 private:
   Geodesic _geod;
@@ -28,25 +36,68 @@ public:
   }
 };
 
-// Build a nearest neighbor index and find k nearest neighbors for query points
-[[cpp11::register]]
-cpp11::writable::list nn_search_cpp(
-    cpp11::doubles dataset_lat, cpp11::doubles dataset_lon,
-    cpp11::doubles query_lat, cpp11::doubles query_lon,
-    int k) {
-  
-  size_t n_data = dataset_lat.size();
-  size_t n_query = query_lat.size();
-  
-  // Build dataset vector
-  vector<pos_t> dataset(n_data);
+// A nearest neighbor index: the dataset and either the vantage-point tree
+// built on it (which stores indices only, so every search needs the points
+// too) or a kd-tree on geocentric coordinates.  Points removed from a
+// kd-tree index have their coordinates set to NaN, so that a rebuild leaves
+// them out while the other points keep their indices.
+struct nn_index {
+  vector<pos_t> dataset;
+  bool kd = false;
+  NearestNeighbor<double, pos_t, GeodesicDist> tree;
+  geographiclib_r::ecef_kdtree kdtree;
+};
+
+// Queries are handed to the worker threads in blocks of this size
+static const size_t nn_query_block = 256;
+
+// Build the tree for index.dataset
+static void nn_index_build_tree(nn_index& index, int nthreads) {
+  if (index.kd) {
+    size_t n_data = index.dataset.size();
+    vector<double> lat(n_data), lon(n_data);
+    for (size_t i = 0; i < n_data; i++) {
+      lat[i] = index.dataset[i].first;
+      lon[i] = index.dataset[i].second;
+    }
+    index.kdtree.build(lat.data(), lon.data(), n_data);
+  } else {
+    GeodesicDist dist(Geodesic::WGS84());
+    index.tree.Initialize(index.dataset, dist, 4,
+                          geographiclib_r::resolve_threads(nthreads));
+  }
+}
+
+static void nn_index_init(nn_index& index, cpp11::doubles lat, cpp11::doubles lon,
+                          int nthreads, bool kd = false) {
+  size_t n_data = lat.size();
+  index.dataset.resize(n_data);
   for (size_t i = 0; i < n_data; i++) {
-    dataset[i] = make_pair(dataset_lat[i], dataset_lon[i]);
+    index.dataset[i] = make_pair(lat[i], lon[i]);
+  }
+  index.kd = kd;
+  nn_index_build_tree(index, nthreads);
+}
+
+// Throws if the index did not survive (e.g. it was restored from a saved
+// workspace, which keeps the R object but not the C++ tree)
+static nn_index& nn_index_get(SEXP index_ptr) {
+  cpp11::external_pointer<nn_index> ptr(index_ptr);
+  if (ptr.get() == nullptr) {
+    cpp11::stop("nearest neighbor index is no longer valid; rebuild it with geodesic_nn_index() or load it with geodesic_nn_load()");
   }
+  return *ptr;
+}
+
+// k nearest neighbors of each query point
+static cpp11::writable::list nn_knn(const nn_index& index,
+                                    cpp11::doubles query_lat, cpp11::doubles query_lon,
+                                    int k, int nthreads) {
+  const vector<pos_t>& dataset = index.dataset;
+  size_t n_data = dataset.size();
+  size_t n_query = query_lat.size();
   
-  // Create distance functor and build the tree
   GeodesicDist dist(Geodesic::WGS84());
-  NearestNeighbor<double, pos_t, GeodesicDist> nn(dataset, dist);
   
   // Each query point gets k neighbors (or fewer if dataset is smaller)
   int actual_k = min(k, static_cast<int>(n_data));
@@ -54,33 +105,49 @@ cpp11::writable::list nn_search_cpp(
   writable::integers idx(n_query * actual_k);
   writable::doubles distances(n_query * actual_k);
   
-  // Search for each query point
-  for (size_t i = 0; i < n_query; i++) {
-    if (ISNAN(query_lat[i]) || ISNAN(query_lon[i])) {
-      for (int j = 0; j < actual_k; j++) {
-        idx[i * actual_k + j] = NA_INTEGER;
-        distances[i * actual_k + j] = NA_REAL;
-      }
-      continue;
-    }
-    
-    pos_t query = make_pair(query_lat[i], query_lon[i]);
+  // Workers only see plain arrays; each block of queries has its own
+  // result buffer and the search costs are tallied afterwards
+  const double* qlat = REAL(query_lat);
+  const double* qlon = REAL(query_lon);
+  int* pidx = INTEGER(idx);
+  double* pdist = REAL(distances);
+  vector<int> costs(n_query, -1);
+  size_t nblocks = (n_query + nn_query_block - 1) / nn_query_block;
+  
+  geographiclib_r::parallel_tasks(nblocks, nthreads, [&](size_t b) {
     vector<int> ind(actual_k);
-    
-    // Search - pass k as parameter
-    nn.Search(dataset, dist, query, ind, actual_k);
-    
-    for (int j = 0; j < actual_k; j++) {
-      if (ind[j] >= 0) {
-        idx[i * actual_k + j] = ind[j] + 1;  // 1-based indexing for R
-        // Compute distance to this neighbor
-        distances[i * actual_k + j] = dist(query, dataset[ind[j]]);
+    vector<double> d(actual_k);
+    size_t i1 = min(n_query, (b + 1) * nn_query_block);
+    for (size_t i = b * nn_query_block; i < i1; i++) {
+      int* oidx = pidx + i * actual_k;
+      double* odist = pdist + i * actual_k;
+      if (ISNAN(qlat[i]) || ISNAN(qlon[i])) {
+        fill(oidx, oidx + actual_k, NA_INTEGER);
+        fill(odist, odist + actual_k, NA_REAL);
+        continue;
+      }
+      
+      pos_t query = make_pair(qlat[i], qlon[i]);
+      if (index.kd) {
+        index.kdtree.knn(qlat[i], qlon[i], actual_k, ind, d);
       } else {
-        idx[i * actual_k + j] = NA_INTEGER;
-        distances[i * actual_k + j] = NA_REAL;
+        index.tree.SearchConst(dataset, dist, query, ind, costs[i], actual_k,
+                               numeric_limits<double>::max(), -1, true, 0, &d);
+      }
+      
+      for (int j = 0; j < actual_k; j++) {
+        if (j < static_cast<int>(ind.size()) && ind[j] >= 0) {
+          oidx[j] = ind[j] + 1;  // 1-based indexing for R
+          // Distance to this neighbor, as found by the search
+          odist[j] = d[j];
+        } else {
+          oidx[j] = NA_INTEGER;
+          odist[j] = NA_REAL;
+        }
       }
     }
-  }
+  });
+  for (size_t i = 0; i < n_query; i++) index.tree.RecordSearch(costs[i]);
   
   // Set dimensions for matrix output (k rows, n_query cols)
   idx.attr("dim") = writable::integers({actual_k, static_cast<int>(n_query)});
@@ -93,66 +160,375 @@ cpp11::writable::list nn_search_cpp(
   return out;
 }
 
-// Find all neighbors within a given radius
-[[cpp11::register]]
-cpp11::writable::list nn_search_radius_cpp(
-    cpp11::doubles dataset_lat, cpp11::doubles dataset_lon,
-    cpp11::doubles query_lat, cpp11::doubles query_lon,
-    double radius) {
-  
-  size_t n_data = dataset_lat.size();
+// All neighbors of each query point within radius.  With csr = false the
+// result is a list of data frames, one per query; with csr = true it is
+// three flat vectors: offset (length n_query + 1, so the neighbors of query
+// i are elements offset[i] + 1, ..., offset[i + 1]), index and distance.
+static cpp11::writable::list nn_radius(const nn_index& index,
+                                       cpp11::doubles query_lat, cpp11::doubles query_lon,
+                                       double radius, int nthreads, bool csr) {
+  const vector<pos_t>& dataset = index.dataset;
+  size_t n_data = dataset.size();
   size_t n_query = query_lat.size();
   
-  // Build dataset vector
-  vector<pos_t> dataset(n_data);
-  for (size_t i = 0; i < n_data; i++) {
-    dataset[i] = make_pair(dataset_lat[i], dataset_lon[i]);
-  }
-  
-  // Create distance functor and build the tree
   GeodesicDist dist(Geodesic::WGS84());
-  NearestNeighbor<double, pos_t, GeodesicDist> nn(dataset, dist);
   
-  // Output is a list of data frames (variable number of neighbors per query)
-  writable::list out(n_query);
+  // Each block of queries collects its neighbors (in query order) into flat
+  // C++ buffers on a worker thread, with the distances found by the search
+  struct block {
+    vector<int> count, ind;
+    vector<double> dist;
+  };
+  const double* qlat = REAL(query_lat);
+  const double* qlon = REAL(query_lon);
+  vector<int> costs(n_query, -1);
+  size_t nblocks = (n_query + nn_query_block - 1) / nn_query_block;
+  vector<block> blocks(nblocks);
   
-  for (size_t i = 0; i < n_query; i++) {
-    if (ISNAN(query_lat[i]) || ISNAN(query_lon[i])) {
-      writable::integers empty_idx;
-      writable::doubles empty_dist;
-      writable::data_frame df({
-        "index"_nm = empty_idx,
-        "distance"_nm = empty_dist
-      });
-      out[i] = df;
-      continue;
+  geographiclib_r::parallel_tasks(nblocks, nthreads, [&](size_t b) {
+    block& out = blocks[b];
+    vector<int> ind;
+    vector<double> d;
+    size_t i0 = b * nn_query_block, i1 = min(n_query, i0 + nn_query_block);
+    out.count.assign(i1 - i0, 0);
+    for (size_t i = i0; i < i1; i++) {
+      if (ISNAN(qlat[i]) || ISNAN(qlon[i])) continue;
+      
+      pos_t query = make_pair(qlat[i], qlon[i]);
+      
+      if (index.kd) {
+        index.kdtree.radius(qlat[i], qlon[i], radius, ind, d);
+      } else {
+        // Search for all points with maxdist = radius
+        // k = n_data to get all potential neighbors
+        index.tree.SearchConst(dataset, dist, query, ind, costs[i],
+                               static_cast<int>(n_data), radius, -1, true, 0, &d);
+      }
+      out.count[i - i0] = static_cast<int>(ind.size());
+      out.ind.insert(out.ind.end(), ind.begin(), ind.end());
+      out.dist.insert(out.dist.end(), d.begin(), d.end());
     }
+  });
+  for (size_t i = 0; i < n_query; i++) index.tree.RecordSearch(costs[i]);
+  
+  if (csr) {
+    size_t total = 0;
+    for (const block& blk : blocks) total += blk.ind.size();
+    if (total > static_cast<size_t>(numeric_limits<int>::max())) {
+      cpp11::stop("too many neighbors (%.0f) for integer offsets", static_cast<double>(total));
+    }
+    writable::integers offset(n_query + 1);
+    writable::integers r_idx(total);
+    writable::doubles r_dist(total);
+    int* poff = INTEGER(offset);
+    int* pidx = INTEGER(r_idx);
+    double* pdist = REAL(r_dist);
     
-    pos_t query = make_pair(query_lat[i], query_lon[i]);
-    
-    // Search for all points with maxdist = radius
-    // k = n_data to get all potential neighbors
-    vector<int> ind(n_data);
-    nn.Search(dataset, dist, query, ind, static_cast<int>(n_data), radius);
-    
-    // Collect valid results (ind[j] >= 0 means a valid neighbor was found)
-    writable::integers r_idx;
-    writable::doubles r_dist;
-    
-    for (size_t j = 0; j < ind.size(); j++) {
-      if (ind[j] >= 0) {
-        double d = dist(query, dataset[ind[j]]);
-        r_idx.push_back(ind[j] + 1);  // 1-based for R
-        r_dist.push_back(d);
+    size_t i = 0, pos = 0;
+    poff[0] = 0;
+    for (const block& blk : blocks) {
+      for (int c : blk.count) {
+        pos += c;
+        poff[++i] = static_cast<int>(pos);
+      }
+    }
+    pos = 0;
+    for (const block& blk : blocks) {
+      for (size_t j = 0; j < blk.ind.size(); j++, pos++) {
+        pidx[pos] = blk.ind[j] + 1;  // 1-based for R
+        pdist[pos] = blk.dist[j];
       }
     }
     
-    writable::data_frame df({
-      "index"_nm = r_idx,
-      "distance"_nm = r_dist
-    });
-    out[i] = df;
+    writable::list out;
+    out.push_back({"offset"_nm = offset});
+    out.push_back({"index"_nm = r_idx});
+    out.push_back({"distance"_nm = r_dist});
+    return out;
   }
   
+  // Output is a list of data frames (variable number of neighbors per query)
+  writable::list out(n_query);
+  
+  size_t i = 0;
+  for (const block& blk : blocks) {
+    size_t pos = 0;
+    for (int c : blk.count) {
+      writable::integers r_idx(c);
+      writable::doubles r_dist(c);
+      for (int j = 0; j < c; j++, pos++) {
+        r_idx[j] = blk.ind[pos] + 1;  // 1-based for R
+        r_dist[j] = blk.dist[pos];
+      }
+      
+      writable::data_frame df({
+        "index"_nm = r_idx,
+        "distance"_nm = r_dist
+      });
+      out[i++] = df;
+    }
+  }
+  
+  return out;
+}
+
+// Build a nearest neighbor index and find k nearest neighbors for query points
+[[cpp11::register]]
+cpp11::writable::list nn_search_cpp(
+    cpp11::doubles dataset_lat, cpp11::doubles dataset_lon,
+    cpp11::doubles query_lat, cpp11::doubles query_lon,
+    int k, int nthreads) {
+  nn_index index;
+  nn_index_init(index, dataset_lat, dataset_lon, nthreads);
+  return nn_knn(index, query_lat, query_lon, k, nthreads);
+}
+
+// Find all neighbors within a given radius
+[[cpp11::register]]
+cpp11::writable::list nn_search_radius_cpp(
+    cpp11::doubles dataset_lat, cpp11::doubles dataset_lon,
+    cpp11::doubles query_lat, cpp11::doubles query_lon,
+    double radius, bool csr, int nthreads) {
+  nn_index index;
+  nn_index_init(index, dataset_lat, dataset_lon, nthreads);
+  return nn_radius(index, query_lat, query_lon, radius, nthreads, csr);
+}
+
+// Build a persistent index, held by R as an external pointer (passed to and
+// from R as SEXP so that the generated registration code needs no types)
+[[cpp11::register]]
+SEXP nn_index_build_cpp(
+    cpp11::doubles dataset_lat, cpp11::doubles dataset_lon, bool kdtree,
+    int nthreads) {
+  nn_index* index = new nn_index;
+  cpp11::external_pointer<nn_index> ptr(index);
+  nn_index_init(*index, dataset_lat, dataset_lon, nthreads, kdtree);
+  return ptr;
+}
+
+// Number of points in an index (NA if the index is no longer valid)
+[[cpp11::register]]
+int nn_index_size_cpp(SEXP index_ptr) {
+  cpp11::external_pointer<nn_index> ptr(index_ptr);
+  if (ptr.get() == nullptr) return NA_INTEGER;
+  return static_cast<int>(ptr->dataset.size());
+}
+
+// Kind of tree in an index
+[[cpp11::register]]
+std::string nn_index_method_cpp(SEXP index_ptr) {
+  return nn_index_get(index_ptr).kd ? "kdtree" : "vptree";
+}
+
+// k nearest neighbors using a prebuilt index
+[[cpp11::register]]
+cpp11::writable::list nn_index_search_cpp(
+    SEXP index_ptr,
+    cpp11::doubles query_lat, cpp11::doubles query_lon,
+    int k, int nthreads) {
+  return nn_knn(nn_index_get(index_ptr), query_lat, query_lon, k, nthreads);
+}
+
+// Radius search using a prebuilt index
+[[cpp11::register]]
+cpp11::writable::list nn_index_search_radius_cpp(
+    SEXP index_ptr,
+    cpp11::doubles query_lat, cpp11::doubles query_lon,
+    double radius, bool csr, int nthreads) {
+  return nn_radius(nn_index_get(index_ptr), query_lat, query_lon, radius, nthreads, csr);
+}
+
+// Add points to an index.  The vantage-point tree is updated in place; the
+// kd-tree is rebuilt, which is cheap as it needs no geodesic calculations.
+[[cpp11::register]]
+void nn_index_insert_cpp(SEXP index_ptr, cpp11::doubles lat, cpp11::doubles lon,
+                         int nthreads) {
+  nn_index& index = nn_index_get(index_ptr);
+  size_t n_new = lat.size();
+  if (index.dataset.size() + n_new > static_cast<size_t>(numeric_limits<int>::max())) {
+    cpp11::stop("too many points for a nearest neighbor index");
+  }
+  for (size_t i = 0; i < n_new; i++) {
+    if (!(std::isfinite(lat[i]) && std::isfinite(lon[i]))) {
+      cpp11::stop("new point %d has non-finite coordinates", static_cast<int>(i + 1));
+    }
+  }
+  for (size_t i = 0; i < n_new; i++) {
+    index.dataset.push_back(make_pair(lat[i], lon[i]));
+  }
+  if (index.kd) {
+    nn_index_build_tree(index, nthreads);
+  } else {
+    GeodesicDist dist(Geodesic::WGS84());
+    index.tree.Insert(index.dataset, dist);
+  }
+}
+
+// Remove points (1-based indices) from an index.  All the indices are
+// checked before any point is removed.
+[[cpp11::register]]
+void nn_index_remove_cpp(SEXP index_ptr, cpp11::integers idx, int nthreads) {
+  nn_index& index = nn_index_get(index_ptr);
+  int n = static_cast<int>(index.dataset.size());
+  vector<char> seen(n, 0);
+  for (R_xlen_t i = 0; i < idx.size(); i++) {
+    int j = idx[i];
+    if (j == NA_INTEGER || j < 1 || j > n) {
+      cpp11::stop("index %d is out of range", j == NA_INTEGER ? 0 : j);
+    }
+    bool gone = index.kd ? std::isnan(index.dataset[j - 1].first) :
+      index.tree.Removed(j - 1);
+    if (gone || seen[j - 1]) {
+      cpp11::stop("point %d has already been removed", j);
+    }
+    seen[j - 1] = 1;
+  }
+  if (index.kd) {
+    for (R_xlen_t i = 0; i < idx.size(); i++) {
+      index.dataset[idx[i] - 1] = make_pair(NA_REAL, NA_REAL);
+    }
+    nn_index_build_tree(index, nthreads);
+  } else {
+    GeodesicDist dist(Geodesic::WGS84());
+    for (R_xlen_t i = 0; i < idx.size(); i++) {
+      index.tree.Remove(index.dataset, dist, idx[i] - 1);
+    }
+  }
+}
+
+// Rebuild the tree of an index from the points which have not been removed
+[[cpp11::register]]
+void nn_index_compact_cpp(SEXP index_ptr, int nthreads) {
+  nn_index& index = nn_index_get(index_ptr);
+  if (index.kd) {
+    nn_index_build_tree(index, nthreads);
+  } else {
+    GeodesicDist dist(Geodesic::WGS84());
+    index.tree.Compact(index.dataset, dist,
+                       geographiclib_r::resolve_threads(nthreads));
+  }
+}
+
+// Update and search statistics for an index (NA where they do not apply to
+// a kd-tree)
+[[cpp11::register]]
+cpp11::writable::list nn_index_stats_cpp(SEXP index_ptr) {
+  const nn_index& index = nn_index_get(index_ptr);
+  int n = static_cast<int>(index.dataset.size()), live = 0;
+  for (int i = 0; i < n; i++) {
+    if (index.kd ? !std::isnan(index.dataset[i].first) : !index.tree.Removed(i)) live++;
+  }
+  int inserted = NA_INTEGER, removed = NA_INTEGER, tombstones = NA_INTEGER,
+    update_cost = NA_INTEGER, depth = NA_INTEGER, balanced_depth = NA_INTEGER,
+    setup_cost = NA_INTEGER, searches = NA_INTEGER;
+  double mean_cost = NA_REAL;
+  if (!index.kd) {
+    int search_cost, min_cost, max_cost;
+    double sd;
+    index.tree.UpdateStatistics(inserted, removed, tombstones, update_cost,
+                                depth, balanced_depth);
+    index.tree.Statistics(setup_cost, searches, search_cost, min_cost, max_cost,
+                          mean_cost, sd);
+    if (searches == 0) mean_cost = NA_REAL;
+  }
+  writable::list out({
+    "points"_nm = n,
+    "live"_nm = live,
+    "inserted"_nm = inserted,
+    "removed"_nm = removed,
+    "tombstones"_nm = tombstones,
+    "depth"_nm = depth,
+    "balanced_depth"_nm = balanced_depth,
+    "setup_cost"_nm = setup_cost,
+    "update_cost"_nm = update_cost,
+    "searches"_nm = searches,
+    "mean_search_cost"_nm = mean_cost
+  });
   return out;
 }
+
+// File layout for a saved index: a 16 byte id, the format version, the kind
+// of tree (0 = vantage-point, 1 = kd), the number of points, the points as
+// (lat, lon) doubles, then for a vantage-point tree the tree in
+// NearestNeighbor's own binary format, which includes the removed points (a
+// kd-tree is cheap to rebuild so is not stored).  Like that format it is not portable between architectures.
+// Version 1 files have no kind field and always hold a vantage-point tree.
+static const char nn_file_id[] = "geographiclib_nn";
+static const int32_t nn_file_version = 2;
+
+[[cpp11::register]]
+void nn_index_save_cpp(SEXP index_ptr, std::string path) {
+  const nn_index& index = nn_index_get(index_ptr);
+  
+  ofstream os(path, ios::binary);
+  if (!os) {
+    cpp11::stop("cannot open file '%s' for writing", path.c_str());
+  }
+  uint64_t n = index.dataset.size();
+  os.write(nn_file_id, 16);
+  int32_t kind = index.kd ? 1 : 0;
+  os.write(reinterpret_cast<const char*>(&nn_file_version), sizeof(nn_file_version));
+  os.write(reinterpret_cast<const char*>(&kind), sizeof(kind));
+  os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  for (size_t i = 0; i < n; i++) {
+    double p[2] = {index.dataset[i].first, index.dataset[i].second};
+    os.write(reinterpret_cast<const char*>(p), sizeof(p));
+  }
+  if (!index.kd) index.tree.Save(os, true);
+  os.close();
+  if (!os) {
+    cpp11::stop("error writing file '%s'", path.c_str());
+  }
+}
+
+[[cpp11::register]]
+SEXP nn_index_load_cpp(std::string path) {
+  ifstream is(path, ios::binary);
+  if (!is) {
+    cpp11::stop("cannot open file '%s' for reading", path.c_str());
+  }
+  char id[16];
+  int32_t version = 0, kind = 0;
+  uint64_t n = 0;
+  is.read(id, 16);
+  is.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!is || string(id, 16) != string(nn_file_id, 16)) {
+    cpp11::stop("'%s' is not a saved nearest neighbor index", path.c_str());
+  }
+  if (version != 1 && version != nn_file_version) {
+    cpp11::stop("'%s' has unsupported index format version %d", path.c_str(),
+                static_cast<int>(version));
+  }
+  if (version > 1) is.read(reinterpret_cast<char*>(&kind), sizeof(kind));
+  is.read(reinterpret_cast<char*>(&n), sizeof(n));
+  if (!is || (kind != 0 && kind != 1)) {
+    cpp11::stop("'%s' is corrupt (bad header)", path.c_str());
+  }
+  if (n > static_cast<uint64_t>(numeric_limits<int>::max())) {
+    cpp11::stop("'%s' is corrupt (bad number of points)", path.c_str());
+  }
+  
+  nn_index* index = new nn_index;
+  cpp11::external_pointer<nn_index> ptr(index);
+  index->dataset.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    double p[2];
+    is.read(reinterpret_cast<char*>(p), sizeof(p));
+    index->dataset[i] = make_pair(p[0], p[1]);
+  }
+  if (!is) {
+    cpp11::stop("'%s' is truncated", path.c_str());
+  }
+  if (kind == 1) {
+    index->kd = true;
+    nn_index_build_tree(*index, 1);
+    return ptr;
+  }
+  // NearestNeighbor::Load validates the tree structure and throws
+  // GeographicErr on bad data
+  index->tree.Load(is, true);
+  if (!is || index->tree.NumPoints() != static_cast<int>(n)) {
+    cpp11::stop("'%s' is corrupt (tree does not match points)", path.c_str());
+  }
+  return ptr;
+}
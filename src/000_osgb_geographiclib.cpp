@@ -4,6 +4,7 @@ namespace writable = cpp11::writable;
 
 #include <string>
 #include <GeographicLib/OSGB.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -11,7 +12,8 @@ using namespace GeographicLib;
 // Forward: Geographic OSGB36 (lon/lat) to OSGB grid (easting/northing)
 // Note: Input should be on OSGB36 datum, not WGS84
 [[cpp11::register]]
-cpp11::writable::data_frame osgb_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat) {
+cpp11::writable::data_frame osgb_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
+                                         int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles easting(nn);
@@ -19,16 +21,17 @@ cpp11::writable::data_frame osgb_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat)
   writable::doubles convergence(nn);
   writable::doubles scale(nn);
   
-  for (size_t i = 0; i < nn; i++) {
-    double e, n, gamma, k;
-    
-    OSGB::Forward(lat[i], lon[i], e, n, gamma, k);
-    
-    easting[i] = e;
-    northing[i] = n;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  double* peasting = REAL(easting);
+  double* pnorthing = REAL(northing);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++)
+      OSGB::Forward(plat[i], plon[i], peasting[i], pnorthing[i],
+                    pconvergence[i], pscale[i]);
+  });
   
   writable::data_frame out({
     "easting"_nm = easting,
@@ -45,7 +48,8 @@ cpp11::writable::data_frame osgb_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat)
 // Reverse: OSGB grid (easting/northing) to Geographic OSGB36 (lon/lat)
 // Note: Output is on OSGB36 datum, not WGS84
 [[cpp11::register]]
-cpp11::writable::data_frame osgb_rev_cpp(cpp11::doubles easting, cpp11::doubles northing) {
+cpp11::writable::data_frame osgb_rev_cpp(cpp11::doubles easting, cpp11::doubles northing,
+                                         int nthreads) {
   size_t nn = easting.size();
   
   writable::doubles lon(nn);
@@ -53,16 +57,17 @@ cpp11::writable::data_frame osgb_rev_cpp(cpp11::doubles easting, cpp11::doubles
   writable::doubles convergence(nn);
   writable::doubles scale(nn);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    
-    OSGB::Reverse(easting[i], northing[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const double* peasting = REAL(easting);
+  const double* pnorthing = REAL(northing);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++)
+      OSGB::Reverse(peasting[i], pnorthing[i], plat[i], plon[i],
+                    pconvergence[i], pscale[i]);
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
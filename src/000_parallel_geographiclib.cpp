@@ -0,0 +1,25 @@
+#include <cpp11.hpp>
+using namespace cpp11;
+
+#include "000_parallel_geographiclib.h"
+
+// Number of threads a wrapper would use for the given setting
+[[cpp11::register]]
+int parallel_threads_cpp(int nthreads) {
+  return geographiclib_r::resolve_threads(nthreads);
+}
+
+// Set the default grain size of parallel_for (if grain > 0) and return the
+// previous value
+[[cpp11::register]]
+int parallel_grain_size_cpp(int grain) {
+  size_t old = geographiclib_r::grain_size().load();
+  if (grain > 0) geographiclib_r::grain_size() = static_cast<size_t>(grain);
+  return static_cast<int>(old);
+}
+
+// Join the worker threads before the shared library is unloaded
+[[cpp11::register]]
+void parallel_shutdown_cpp() {
+  geographiclib_r::worker_pool::instance().shutdown();
+}
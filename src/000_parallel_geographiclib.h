@@ -0,0 +1,233 @@
+#ifndef GEOGRAPHICLIB_R_PARALLEL_H
+#define GEOGRAPHICLIB_R_PARALLEL_H
+
+// Worker threads for the vectorised wrappers.
+//
+// Nothing in here touches the R API: callers extract raw pointers from their
+// cpp11 vectors on the main thread, hand those to the workers, and build R
+// objects only after the parallel region has finished.
+//
+// The workers belong to a pool which is started on first use and kept for
+// the life of the process, so a call on a short vector costs a wake-up
+// rather than a thread creation per worker.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace geographiclib_r {
+
+// Number of workers to use; nthreads <= 0 means all available cores
+inline int resolve_threads(int nthreads) {
+  if (nthreads > 0) return nthreads;
+  unsigned hw = std::thread::hardware_concurrency();
+  return hw > 0 ? static_cast<int>(hw) : 1;
+}
+
+// Persistent worker threads.  One job runs at a time: run() hands its tasks
+// to the calling thread and up to nworkers - 1 pool threads, and returns
+// when they are all done.  A job started while another is running (from
+// inside a task, say) runs on its calling thread alone.
+class worker_pool {
+public:
+  static worker_pool& instance() {
+    static worker_pool pool;
+    return pool;
+  }
+
+  void run(size_t ntasks, size_t nworkers,
+           const std::function<void(size_t)>& task) {
+    bool idle = false;
+    if (nworkers <= 1 || !_running.compare_exchange_strong(idle, true)) {
+      for (size_t k = 0; k < ntasks; k++) task(k);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      while (_threads.size() < nworkers - 1)
+        _threads.emplace_back(&worker_pool::loop, this, _job);
+      _task = &task;
+      _ntasks = ntasks;
+      _next = 0;
+      _err = nullptr;
+      _wanted = nworkers - 1;
+      ++_job;
+    }
+    _wake.notify_all();
+    work();
+    std::exception_ptr err;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _wanted = 0;
+      _done.wait(lock, [this] { return _active == 0; });
+      _task = nullptr;
+      err = _err;
+    }
+    _running = false;
+    if (err) std::rethrow_exception(err);
+  }
+
+  // Stop and join the pool threads (they are started again when needed).
+  // Called when the package is unloaded, so that no thread is left running
+  // code that is about to disappear.
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& th : _threads) th.join();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _threads.clear();
+    _stop = false;
+  }
+
+  ~worker_pool() { shutdown(); }
+
+private:
+  std::atomic<bool> _running{false};
+  std::mutex _mutex;
+  std::condition_variable _wake, _done;
+  std::vector<std::thread> _threads;
+  const std::function<void(size_t)>* _task = nullptr;
+  size_t _ntasks = 0, _wanted = 0, _active = 0, _job = 0;
+  std::atomic<size_t> _next{0};
+  std::exception_ptr _err;
+  bool _stop = false;
+
+  worker_pool() {}
+
+  // Take tasks until there are none left; the first exception ends the job
+  void work() {
+    try {
+      for (size_t k = _next++; k < _ntasks; k = _next++) (*_task)(k);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_err) _err = std::current_exception();
+      _next = _ntasks;
+    }
+  }
+
+  // seen is the last job the thread need not join
+  void loop(size_t seen) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+      _wake.wait(lock, [&] { return _stop || (_job != seen && _wanted > 0); });
+      if (_stop) return;
+      seen = _job;
+      --_wanted;
+      ++_active;
+      lock.unlock();
+      work();
+      lock.lock();
+      if (--_active == 0) _done.notify_all();
+    }
+  }
+};
+
+// Run task(k) for k in [0, ntasks), handing tasks out dynamically to
+// nthreads workers.  The calling thread is one of the workers.  The first
+// exception thrown by any task is rethrown on the calling thread.
+//
+// Tasks must not touch the R API, even to read a cpp11 vector: take raw
+// pointers (REAL(), INTEGER(), ...) on the calling thread before the call
+// and capture those.  The same goes for parallel_for and the distance
+// matrix helpers below.
+template <class Task>
+void parallel_tasks(size_t ntasks, int nthreads, Task task) {
+  if (ntasks == 0) return;
+  size_t nw = std::min(static_cast<size_t>(resolve_threads(nthreads)), ntasks);
+  if (nw <= 1) {
+    for (size_t k = 0; k < ntasks; k++) task(k);
+    return;
+  }
+  std::function<void(size_t)> f(std::ref(task));
+  worker_pool::instance().run(ntasks, nw, f);
+}
+
+// Default number of elements in each task of parallel_for
+inline std::atomic<size_t>& grain_size() {
+  static std::atomic<size_t> grain(1024);
+  return grain;
+}
+
+// Run body(i0, i1) over consecutive ranges covering [0, n), each of at most
+// grain elements (default grain_size()), on nthreads workers.  Vectors of at
+// most one grain run on the calling thread without touching the pool.
+template <class Body>
+void parallel_for(size_t n, int nthreads, Body body, size_t grain = 0) {
+  if (grain == 0) grain = std::max(grain_size().load(), static_cast<size_t>(1));
+  size_t ntasks = (n + grain - 1) / grain;
+  if (ntasks <= 1) {
+    if (n > 0) body(static_cast<size_t>(0), n);
+    return;
+  }
+  parallel_tasks(ntasks, nthreads, [&](size_t k) {
+    body(k * grain, std::min(n, (k + 1) * grain));
+  });
+}
+
+// Fill an n1 x n2 column-major matrix out[i + j * n1] = dist(i, j), one row
+// segment at a time: row(i, j0, j1, buf) sets buf[j - j0] = dist(i, j) for j
+// in [j0, j1), so per-row work (e.g. setting up point i as the origin of the
+// inverse problem) is done once per segment rather than once per element.
+//
+// The matrix is split into square tiles of side `tile` which are handed out
+// to the workers, so each worker keeps one block of rows and columns hot in
+// cache.  With symmetric = true (both point sets are the same, n1 == n2)
+// only the tiles on or above the diagonal are computed and each value is
+// mirrored into the lower triangle.
+template <class Row>
+void distance_matrix_rows(size_t n1, size_t n2, bool symmetric, int nthreads,
+                          double* out, Row row, size_t tile = 64) {
+  size_t nt1 = (n1 + tile - 1) / tile;
+  size_t nt2 = (n2 + tile - 1) / tile;
+
+  // Tile coordinates, upper triangle only in the symmetric case
+  std::vector<std::pair<size_t, size_t>> tiles;
+  tiles.reserve(symmetric ? nt1 * (nt1 + 1) / 2 : nt1 * nt2);
+  for (size_t tj = 0; tj < nt2; tj++) {
+    for (size_t ti = 0; ti < nt1; ti++) {
+      if (symmetric && ti > tj) break;
+      tiles.emplace_back(ti, tj);
+    }
+  }
+
+  parallel_tasks(tiles.size(), nthreads, [&](size_t k) {
+    size_t i0 = tiles[k].first * tile, i1 = std::min(i0 + tile, n1);
+    size_t j0 = tiles[k].second * tile, j1 = std::min(j0 + tile, n2);
+    std::vector<double> buf(j1 - j0);
+    for (size_t i = i0; i < i1; i++) {
+      // Only j >= i in the symmetric case
+      size_t jbeg = symmetric ? std::max(j0, i) : j0;
+      if (jbeg >= j1) continue;
+      row(i, jbeg, j1, buf.data());
+      for (size_t j = jbeg; j < j1; j++) {
+        double d = buf[j - jbeg];
+        out[i + j * n1] = d;
+        if (symmetric) out[j + i * n1] = d;
+      }
+    }
+  });
+}
+
+// As distance_matrix_rows, for an element-wise dist(i, j)
+template <class Dist>
+void distance_matrix(size_t n1, size_t n2, bool symmetric, int nthreads,
+                     double* out, Dist dist, size_t tile = 64) {
+  distance_matrix_rows(n1, n2, symmetric, nthreads, out,
+    [&](size_t i, size_t j0, size_t j1, double* buf) {
+      for (size_t j = j0; j < j1; j++) buf[j - j0] = dist(i, j);
+    }, tile);
+}
+
+} // namespace geographiclib_r
+
+#endif // GEOGRAPHICLIB_R_PARALLEL_H
@@ -4,6 +4,7 @@ namespace writable = cpp11::writable;
 
 #include <GeographicLib/PolarStereographic.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -11,7 +12,8 @@ using namespace GeographicLib;
 // Forward: Geographic (lon/lat) to Polar Stereographic (x/y)
 [[cpp11::register]]
 cpp11::writable::data_frame polarstereo_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                                 cpp11::logicals northp, double k0) {
+                                                 cpp11::logicals northp, double k0,
+                                                 int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -21,16 +23,25 @@ cpp11::writable::data_frame polarstereo_fwd_cpp(cpp11::doubles lon, cpp11::doubl
   
   const PolarStereographic& ps = PolarStereographic::UPS();
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    ps.Forward(northp[i], lat[i], lon[i], xx, yy, gamma, k);
-    
-    // Apply custom scale factor (UPS uses 0.994)
-    x[i] = xx * k0 / 0.994;
-    y[i] = yy * k0 / 0.994;
-    convergence[i] = gamma;
-    scale[i] = k * k0 / 0.994;
-  }
+  const int* pnorthp = LOGICAL(northp);
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      ps.Forward(pnorthp[i] == TRUE, plat[i], plon[i], xx, yy, gamma, k);
+      
+      // Apply custom scale factor (UPS uses 0.994)
+      px[i] = xx * k0 / 0.994;
+      py[i] = yy * k0 / 0.994;
+      pconvergence[i] = gamma;
+      pscale[i] = k * k0 / 0.994;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -48,7 +59,8 @@ cpp11::writable::data_frame polarstereo_fwd_cpp(cpp11::doubles lon, cpp11::doubl
 // Reverse: Polar Stereographic (x/y) to Geographic (lon/lat)
 [[cpp11::register]]
 cpp11::writable::data_frame polarstereo_rev_cpp(cpp11::doubles x, cpp11::doubles y,
-                                                 cpp11::logicals northp, double k0) {
+                                                 cpp11::logicals northp, double k0,
+                                                 int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -58,16 +70,25 @@ cpp11::writable::data_frame polarstereo_rev_cpp(cpp11::doubles x, cpp11::doubles
   
   const PolarStereographic& ps = PolarStereographic::UPS();
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    // Undo custom scale factor
-    ps.Reverse(northp[i], x[i] * 0.994 / k0, y[i] * 0.994 / k0, la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k * k0 / 0.994;
-  }
+  const int* pnorthp = LOGICAL(northp);
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      // Undo custom scale factor
+      ps.Reverse(pnorthp[i] == TRUE, px[i] * 0.994 / k0, py[i] * 0.994 / k0, la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k * k0 / 0.994;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
@@ -85,7 +106,8 @@ cpp11::writable::data_frame polarstereo_rev_cpp(cpp11::doubles x, cpp11::doubles
 // Forward with custom parameters (not using UPS defaults)
 [[cpp11::register]]
 cpp11::writable::data_frame polarstereo_fwd_custom_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                                        cpp11::logicals northp, double k0) {
+                                                        cpp11::logicals northp, double k0,
+                                                        int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -96,15 +118,24 @@ cpp11::writable::data_frame polarstereo_fwd_custom_cpp(cpp11::doubles lon, cpp11
   // Create custom polar stereographic with specified scale
   const PolarStereographic ps(Constants::WGS84_a(), Constants::WGS84_f(), k0);
   
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    ps.Forward(northp[i], lat[i], lon[i], xx, yy, gamma, k);
-    
-    x[i] = xx;
-    y[i] = yy;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const int* pnorthp = LOGICAL(northp);
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      ps.Forward(pnorthp[i] == TRUE, plat[i], plon[i], xx, yy, gamma, k);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -122,7 +153,8 @@ cpp11::writable::data_frame polarstereo_fwd_custom_cpp(cpp11::doubles lon, cpp11
 // Reverse with custom parameters
 [[cpp11::register]]
 cpp11::writable::data_frame polarstereo_rev_custom_cpp(cpp11::doubles x, cpp11::doubles y,
-                                                        cpp11::logicals northp, double k0) {
+                                                        cpp11::logicals northp, double k0,
+                                                        int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -132,15 +164,24 @@ cpp11::writable::data_frame polarstereo_rev_custom_cpp(cpp11::doubles x, cpp11::
   
   const PolarStereographic ps(Constants::WGS84_a(), Constants::WGS84_f(), k0);
   
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    ps.Reverse(northp[i], x[i], y[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-  }
+  const int* pnorthp = LOGICAL(northp);
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      ps.Reverse(pnorthp[i] == TRUE, px[i], py[i], la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
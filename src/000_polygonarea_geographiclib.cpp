@@ -2,74 +2,173 @@
 using namespace cpp11;
 namespace writable = cpp11::writable;
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 #include <GeographicLib/PolygonArea.hpp>
 #include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/Intersect.hpp>
+#include <GeographicLib/Rhumb.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
+#include "000_segindex_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
 
+// Rows of (feature, part, ring) ids, grouped by ring in one pass.  The rows
+// of a ring need not be contiguous; within a ring they keep their order.
+struct polygon_key {
+  int feature, part, ring;
+  bool operator==(const polygon_key& o) const {
+    return feature == o.feature && part == o.part && ring == o.ring;
+  }
+};
+
+struct polygon_key_hash {
+  size_t operator()(const polygon_key& k) const {
+    uint64_t h = static_cast<uint32_t>(k.feature);
+    h = h * 0x9e3779b97f4a7c15ULL + static_cast<uint32_t>(k.part);
+    h = h * 0x9e3779b97f4a7c15ULL + static_cast<uint32_t>(k.ring);
+    return static_cast<size_t>(h ^ (h >> 29));
+  }
+};
+
+struct polygon_groups {
+  vector<int> feature_id;        // Feature ids in order of first appearance
+  vector<size_t> part_feature;   // Feature of each part
+  vector<int> part_exterior;     // Smallest ring id of each part
+  vector<size_t> ring_part;      // Part of each ring
+  vector<int> ring_id;           // Ring id of each ring
+  vector<size_t> ring_start;     // Rows of ring r are order[ring_start[r] ..
+  vector<size_t> order;          //   ring_start[r + 1])
+};
+
+// part and ring may be null (every feature is a single part or ring)
+static void polygon_group(size_t nn, const int* feature, const int* part,
+                          const int* ring, polygon_groups& g) {
+  unordered_map<int, size_t> features;
+  unordered_map<polygon_key, size_t, polygon_key_hash> parts, rings;
+  vector<size_t> ring_of(nn), count;
+  polygon_key last{0, 0, 0};
+  size_t cur = 0;
+  for (size_t i = 0; i < nn; i++) {
+    polygon_key k{feature[i], part ? part[i] : 0, ring ? ring[i] : 0};
+    // Consecutive rows are usually in the same ring
+    if (i == 0 || !(k == last)) {
+      auto r = rings.emplace(k, g.ring_id.size());
+      if (r.second) {
+        polygon_key kp{k.feature, k.part, 0};
+        auto q = parts.emplace(kp, g.part_feature.size());
+        if (q.second) {
+          auto f = features.emplace(k.feature, g.feature_id.size());
+          if (f.second) g.feature_id.push_back(k.feature);
+          g.part_feature.push_back(f.first->second);
+          g.part_exterior.push_back(k.ring);
+        } else {
+          int& ext = g.part_exterior[q.first->second];
+          ext = min(ext, k.ring);
+        }
+        g.ring_part.push_back(q.first->second);
+        g.ring_id.push_back(k.ring);
+        count.push_back(0);
+      }
+      cur = r.first->second;
+      last = k;
+    }
+    ring_of[i] = cur;
+    count[cur]++;
+  }
+  size_t nrings = count.size();
+  g.ring_start.assign(nrings + 1, 0);
+  for (size_t r = 0; r < nrings; r++)
+    g.ring_start[r + 1] = g.ring_start[r] + count[r];
+  // Stable counting sort of the rows by ring
+  vector<size_t> next(g.ring_start.begin(), g.ring_start.end() - 1);
+  g.order.resize(nn);
+  for (size_t i = 0; i < nn; i++) g.order[next[ring_of[i]]++] = i;
+}
+
 // Compute geodesic polygon area and perimeter on the ellipsoid
 // Takes vectors of lon/lat coordinates defining polygon vertices
-// Polygons can be split by an id vector to compute multiple polygons at once
+// Polygons are given by an id vector, with optional part and ring ids for
+// multipolygons and holes; rows may be in any order
 [[cpp11::register]]
 cpp11::writable::data_frame polygonarea_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                            cpp11::integers id, bool polyline) {
+                                            cpp11::integers id, cpp11::integers part,
+                                            cpp11::integers ring, bool polyline,
+                                            int nthreads) {
 
-  // Get unique polygon IDs and count them
   size_t nn = lon.size();
+  bool has_part = part.size() > 0, has_ring = ring.size() > 0;
 
-  // Find unique IDs and their counts
-  std::vector<int> unique_ids;
-  std::vector<size_t> start_idx;
-  std::vector<size_t> counts;
-
-  int current_id = id[0];
-  unique_ids.push_back(current_id);
-  start_idx.push_back(0);
-  size_t count = 1;
-
-  for (size_t i = 1; i < nn; i++) {
-    if (id[i] != current_id) {
-      counts.push_back(count);
-      current_id = id[i];
-      unique_ids.push_back(current_id);
-      start_idx.push_back(i);
-      count = 1;
-    } else {
-      count++;
-    }
-  }
-  counts.push_back(count);
+  polygon_groups g;
+  polygon_group(nn, INTEGER(id), has_part ? INTEGER(part) : nullptr,
+                has_ring ? INTEGER(ring) : nullptr, g);
+  size_t nrings = g.ring_id.size();
 
-  size_t n_polys = unique_ids.size();
-
-  // Output vectors
-  writable::doubles area(n_polys);
-  writable::doubles perimeter(n_polys);
-  writable::integers n_points(n_polys);
-  writable::integers polygon_id(n_polys);
+  // Area, perimeter and vertex count of each ring
+  vector<double> ring_area(nrings), ring_perimeter(nrings);
+  vector<unsigned> ring_n(nrings);
 
   // Use WGS84 geodesic
   const Geodesic& geod = Geodesic::WGS84();
 
-  for (size_t p = 0; p < n_polys; p++) {
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  const size_t* porder = g.order.data();
+  const size_t* pstart = g.ring_start.data();
+  double* parea = ring_area.data();
+  double* pperimeter = ring_perimeter.data();
+  unsigned* pn = ring_n.data();
+  // About 16k vertices per task, however the rings are sized
+  size_t grain = max<size_t>(1, nn ? 16384 * nrings / nn : 1);
+  geographiclib_r::parallel_for(nrings, nthreads, [&](size_t r0, size_t r1) {
     PolygonArea poly(geod, polyline);
-
-    size_t start = start_idx[p];
-    size_t end = start + counts[p];
-
-    for (size_t i = start; i < end; i++) {
-      poly.AddPoint(lat[i], lon[i]);
+    for (size_t r = r0; r < r1; r++) {
+      poly.Clear();
+      for (size_t k = pstart[r]; k < pstart[r + 1]; k++) {
+        size_t i = porder[k];
+        poly.AddPoint(plat[i], plon[i]);
+      }
+      double perim = 0, ar = NA_REAL;
+      pn[r] = poly.Compute(false, true, perim, ar);
+      parea[r] = polyline ? NA_REAL : ar;
+      pperimeter[r] = perim;
     }
+  }, grain);
+
+  // Sum the rings of each feature.  With ring ids the smallest ring of each
+  // part is its exterior and the others are holes, so the area is the
+  // exterior's less the holes' whatever their orientation; otherwise the
+  // signed areas are added.
+  size_t n_polys = g.feature_id.size();
+  vector<double> sum_area(n_polys, polyline ? NA_REAL : 0.0), sum_perimeter(n_polys, 0.0);
+  vector<int> sum_n(n_polys, 0);
+  for (size_t r = 0; r < nrings; r++) {
+    size_t pt = g.ring_part[r], p = g.part_feature[pt];
+    if (!polyline) {
+      double a = ring_area[r];
+      if (has_ring)
+        a = g.ring_id[r] == g.part_exterior[pt] ? fabs(a) : -fabs(a);
+      sum_area[p] += a;
+    }
+    sum_perimeter[p] += ring_perimeter[r];
+    sum_n[p] += static_cast<int>(ring_n[r]);
+  }
 
-    double perim, ar;
-    unsigned npts = poly.Compute(false, true, perim, ar);
-
-    area[p] = ar;
-    perimeter[p] = perim;
-    n_points[p] = (int)npts;
-    polygon_id[p] = unique_ids[p];
+  writable::doubles area(n_polys);
+  writable::doubles perimeter(n_polys);
+  writable::integers n_points(n_polys);
+  writable::integers polygon_id(n_polys);
+  for (size_t p = 0; p < n_polys; p++) {
+    area[p] = sum_area[p];
+    perimeter[p] = sum_perimeter[p];
+    n_points[p] = sum_n[p];
+    polygon_id[p] = g.feature_id[p];
   }
 
   writable::data_frame out({
@@ -141,3 +240,578 @@ cpp11::writable::data_frame polygonarea_cumulative_cpp(cpp11::doubles lon, cpp11
 
   return out;
 }
+
+// Streaming accumulation: the running state of each id, kept between chunks
+// of vertices.  Only the vector for the accumulator's method is used.
+struct polygon_accumulator {
+  bool polyline, rhumb;
+  vector<int> ids;                  // Ids in order of first appearance
+  unordered_map<int, size_t> index; // Slot of each id
+  vector<PolygonArea::State> geodesic;
+  vector<PolygonAreaRhumb::State> loxodrome;
+};
+
+static vector<PolygonArea::State>& accumulator_states(polygon_accumulator& acc,
+                                                      const Geodesic&) {
+  return acc.geodesic;
+}
+
+static vector<PolygonAreaRhumb::State>& accumulator_states(polygon_accumulator& acc,
+                                                           const Rhumb&) {
+  return acc.loxodrome;
+}
+
+static polygon_accumulator& accumulator_get(SEXP acc_ptr) {
+  cpp11::external_pointer<polygon_accumulator> ptr(acc_ptr);
+  if (ptr.get() == nullptr) {
+    cpp11::stop("polygon accumulator is no longer valid; restore it from a snapshot with polygon_accumulator_restore()");
+  }
+  return *ptr;
+}
+
+// Slot of id, starting a new polygon for an id not seen before
+template <class G>
+static size_t accumulator_slot(polygon_accumulator& acc, const G& earth, int id) {
+  auto r = acc.index.emplace(id, acc.ids.size());
+  if (r.second) {
+    acc.ids.push_back(id);
+    accumulator_states(acc, earth).push_back(PolygonAreaT<G>(earth, acc.polyline).GetState());
+  }
+  return r.first->second;
+}
+
+template <class G>
+static void accumulator_add(polygon_accumulator& acc, const G& earth,
+                            const double* plon, const double* plat,
+                            const int* id, size_t nn, int nthreads) {
+  // Rows of each id in the chunk, in order; ids are independent so they are
+  // shared out between threads
+  polygon_groups g;
+  polygon_group(nn, id, nullptr, nullptr, g);
+  size_t ngroups = g.feature_id.size();
+  vector<size_t> slot(ngroups);
+  for (size_t k = 0; k < ngroups; k++)
+    slot[k] = accumulator_slot(acc, earth, g.feature_id[k]);
+
+  typename PolygonAreaT<G>::State* pstate = accumulator_states(acc, earth).data();
+  const size_t* pslot = slot.data();
+  const size_t* porder = g.order.data();
+  const size_t* pstart = g.ring_start.data();
+  bool polyline = acc.polyline;
+  size_t grain = max<size_t>(1, nn ? 16384 * ngroups / nn : 1);
+  geographiclib_r::parallel_for(ngroups, nthreads, [&](size_t k0, size_t k1) {
+    PolygonAreaT<G> poly(earth, polyline);
+    for (size_t k = k0; k < k1; k++) {
+      poly.SetState(pstate[pslot[k]]);
+      for (size_t j = pstart[k]; j < pstart[k + 1]; j++) {
+        size_t i = porder[j];
+        poly.AddPoint(plat[i], plon[i]);
+      }
+      pstate[pslot[k]] = poly.GetState();
+    }
+  }, grain);
+}
+
+template <class G>
+static void accumulator_compute(const polygon_accumulator& acc, const G& earth,
+                                const vector<typename PolygonAreaT<G>::State>& states,
+                                size_t s, double& area, double& perimeter, int& n) {
+  PolygonAreaT<G> poly(earth, acc.polyline);
+  poly.SetState(states[s]);
+  double ar = NA_REAL;
+  n = static_cast<int>(poly.Compute(false, true, perimeter, ar));
+  area = acc.polyline ? NA_REAL : ar;
+}
+
+// New, empty accumulator
+[[cpp11::register]]
+SEXP polygon_accumulator_new_cpp(bool polyline, bool rhumb) {
+  polygon_accumulator* acc = new polygon_accumulator();
+  acc->polyline = polyline;
+  acc->rhumb = rhumb;
+  cpp11::external_pointer<polygon_accumulator> ptr(acc);
+  return ptr;
+}
+
+// Add a chunk of vertices; the rows of each id continue its polygon
+[[cpp11::register]]
+void polygon_accumulator_add_cpp(SEXP acc_ptr, cpp11::doubles lon, cpp11::doubles lat,
+                                 cpp11::integers id, int nthreads) {
+  polygon_accumulator& acc = accumulator_get(acc_ptr);
+  size_t nn = lon.size();
+  if (acc.rhumb)
+    accumulator_add(acc, Rhumb::WGS84(), REAL(lon), REAL(lat), INTEGER(id), nn,
+                    nthreads);
+  else
+    accumulator_add(acc, Geodesic::WGS84(), REAL(lon), REAL(lat), INTEGER(id), nn,
+                    nthreads);
+}
+
+// Area and perimeter of the given ids (all if id is empty) as if each
+// polygon were closed now; remove forgets them afterwards
+[[cpp11::register]]
+cpp11::writable::data_frame polygon_accumulator_result_cpp(SEXP acc_ptr,
+                                                           cpp11::integers id,
+                                                           bool remove) {
+  polygon_accumulator& acc = accumulator_get(acc_ptr);
+  bool all = id.size() == 0;
+  size_t nout = all ? acc.ids.size() : static_cast<size_t>(id.size());
+
+  writable::integers out_id(nout);
+  writable::doubles area(nout);
+  writable::doubles perimeter(nout);
+  writable::integers n_points(nout);
+  vector<bool> drop(acc.ids.size(), false);
+  for (size_t k = 0; k < nout; k++) {
+    int key = all ? acc.ids[k] : id[k];
+    out_id[k] = key;
+    auto it = acc.index.find(key);
+    if (it == acc.index.end()) {
+      area[k] = NA_REAL;
+      perimeter[k] = NA_REAL;
+      n_points[k] = 0;
+      continue;
+    }
+    double ar, perim = 0;
+    int n;
+    if (acc.rhumb)
+      accumulator_compute(acc, Rhumb::WGS84(), acc.loxodrome, it->second, ar, perim, n);
+    else
+      accumulator_compute(acc, Geodesic::WGS84(), acc.geodesic, it->second, ar, perim, n);
+    area[k] = ar;
+    perimeter[k] = perim;
+    n_points[k] = n;
+    drop[it->second] = true;
+  }
+
+  if (remove) {
+    // Compact the slots, keeping the order of the rest
+    size_t m = 0;
+    for (size_t s = 0; s < acc.ids.size(); s++) {
+      if (drop[s]) continue;
+      acc.ids[m] = acc.ids[s];
+      if (acc.rhumb) acc.loxodrome[m] = acc.loxodrome[s];
+      else acc.geodesic[m] = acc.geodesic[s];
+      m++;
+    }
+    acc.ids.resize(m);
+    if (acc.rhumb) acc.loxodrome.resize(m);
+    else acc.geodesic.resize(m);
+    acc.index.clear();
+    for (size_t s = 0; s < m; s++) acc.index.emplace(acc.ids[s], s);
+  }
+
+  writable::data_frame out({
+    "id"_nm = out_id,
+      "area"_nm = area,
+      "perimeter"_nm = perimeter,
+      "n"_nm = n_points
+  });
+
+  return out;
+}
+
+template <class S>
+static cpp11::writable::data_frame accumulator_snapshot(const vector<int>& ids,
+                                                        const vector<S>& states) {
+  size_t m = ids.size();
+  writable::integers id(m), n(m), crossings(m);
+  writable::doubles lat0(m), lon0(m), lat1(m), lon1(m);
+  writable::doubles area_s(m), area_t(m), perimeter_s(m), perimeter_t(m);
+  for (size_t s = 0; s < m; s++) {
+    const S& st = states[s];
+    id[s] = ids[s];
+    n[s] = static_cast<int>(st.num);
+    crossings[s] = st.crossings;
+    lat0[s] = st.lat0; lon0[s] = st.lon0;
+    lat1[s] = st.lat1; lon1[s] = st.lon1;
+    area_s[s] = st.area[0]; area_t[s] = st.area[1];
+    perimeter_s[s] = st.perimeter[0]; perimeter_t[s] = st.perimeter[1];
+  }
+  writable::data_frame out({
+    "id"_nm = id,
+      "n"_nm = n,
+      "crossings"_nm = crossings,
+      "lat0"_nm = lat0,
+      "lon0"_nm = lon0,
+      "lat1"_nm = lat1,
+      "lon1"_nm = lon1,
+      "area_s"_nm = area_s,
+      "area_t"_nm = area_t,
+      "perimeter_s"_nm = perimeter_s,
+      "perimeter_t"_nm = perimeter_t
+  });
+  return out;
+}
+
+// The exact state of every id: the first and current points, the number of
+// points and meridian crossings, and both words of each sum
+[[cpp11::register]]
+cpp11::writable::data_frame polygon_accumulator_snapshot_cpp(SEXP acc_ptr) {
+  polygon_accumulator& acc = accumulator_get(acc_ptr);
+  if (acc.rhumb)
+    return accumulator_snapshot(acc.ids, acc.loxodrome);
+  return accumulator_snapshot(acc.ids, acc.geodesic);
+}
+
+// The columns of a snapshot, as given by polygon_accumulator_snapshot_cpp()
+struct accumulator_columns {
+  cpp11::integers id, n, crossings;
+  cpp11::doubles lat0, lon0, lat1, lon1, area_s, area_t, perimeter_s, perimeter_t;
+};
+
+template <class S>
+static void accumulator_restore(polygon_accumulator& acc, vector<S>& states,
+                                const accumulator_columns& c) {
+  size_t m = c.id.size();
+  states.resize(m);
+  acc.ids.resize(m);
+  for (size_t s = 0; s < m; s++) {
+    if (c.id[s] == NA_INTEGER || c.n[s] == NA_INTEGER || c.n[s] < 0 ||
+        c.crossings[s] == NA_INTEGER)
+      cpp11::stop("snapshot row %d is not a valid polygon state", static_cast<int>(s + 1));
+    if (!acc.index.emplace(c.id[s], s).second)
+      cpp11::stop("snapshot id %d appears more than once", static_cast<int>(c.id[s]));
+    S& st = states[s];
+    acc.ids[s] = c.id[s];
+    st.num = static_cast<unsigned>(c.n[s]);
+    st.crossings = c.crossings[s];
+    st.lat0 = c.lat0[s]; st.lon0 = c.lon0[s];
+    st.lat1 = c.lat1[s]; st.lon1 = c.lon1[s];
+    st.area[0] = c.area_s[s]; st.area[1] = c.area_t[s];
+    st.perimeter[0] = c.perimeter_s[s]; st.perimeter[1] = c.perimeter_t[s];
+  }
+}
+
+// New accumulator holding the state recorded by a snapshot
+[[cpp11::register]]
+SEXP polygon_accumulator_restore_cpp(cpp11::integers id, cpp11::integers n,
+                                     cpp11::integers crossings,
+                                     cpp11::doubles lat0, cpp11::doubles lon0,
+                                     cpp11::doubles lat1, cpp11::doubles lon1,
+                                     cpp11::doubles area_s, cpp11::doubles area_t,
+                                     cpp11::doubles perimeter_s,
+                                     cpp11::doubles perimeter_t,
+                                     bool polyline, bool rhumb) {
+  accumulator_columns c{id, n, crossings, lat0, lon0, lat1, lon1,
+                        area_s, area_t, perimeter_s, perimeter_t};
+  polygon_accumulator* acc = new polygon_accumulator();
+  cpp11::external_pointer<polygon_accumulator> ptr(acc);
+  acc->polyline = polyline;
+  acc->rhumb = rhumb;
+  if (rhumb)
+    accumulator_restore(*acc, acc->loxodrome, c);
+  else
+    accumulator_restore(*acc, acc->geodesic, c);
+  return ptr;
+}
+
+// Number of ids in an accumulator (NA if it is no longer valid)
+[[cpp11::register]]
+int polygon_accumulator_size_cpp(SEXP acc_ptr) {
+  cpp11::external_pointer<polygon_accumulator> ptr(acc_ptr);
+  if (ptr.get() == nullptr) return NA_INTEGER;
+  return static_cast<int>(ptr->ids.size());
+}
+
+// Validity of polygons: missing and repeated vertices, crossings of their
+// edges and the orientation of each ring.
+enum { ISSUE_MISSING = 1, ISSUE_DUPLICATE = 2, ISSUE_CROSSING = 3 };
+
+struct validity_issue {
+  int type;
+  size_t row1, row2;            // Rows of the vertices, or of the first
+                                //   vertices of the crossing edges
+  size_t ring1, ring2;
+  double lat, lon;
+};
+
+struct validity_ring {
+  int n = 0;                    // Distinct vertices
+  double area = 0;              // Signed area (counterclockwise positive)
+  int duplicates = 0, crossings = 0, missing = 0;
+};
+
+// Check the rings of one polygon.  Edges are tested with Intersect::Segment
+// only when their boxes overlap.  Neighboring edges always meet at their
+// shared vertex; they only overlap if the ring doubles back there, i.e., the
+// azimuth turns by 180 degrees.  The edge boxes are found on nthreads.
+static void polygon_check(const Geodesic& geod, const Intersect& inter,
+                          const double* lat, const double* lon,
+                          const polygon_groups& g, const size_t* rings,
+                          size_t nrings, validity_ring* out,
+                          vector<validity_issue>& issues, int nthreads) {
+  const double tol = 1e-3;      // meters
+  // The vertices of each ring, without missing ones, repeats of the previous
+  // vertex or the closing repeat of the first
+  vector<size_t> v, ring_of, v_start(1, 0);
+  for (size_t q = 0; q < nrings; q++) {
+    size_t r = rings[q];
+    validity_ring& o = out[r];
+    size_t first = v.size();
+    for (size_t k = g.ring_start[r]; k < g.ring_start[r + 1]; k++) {
+      size_t i = g.order[k];
+      if (ISNAN(lat[i]) || ISNAN(lon[i])) {
+        issues.push_back({ISSUE_MISSING, i, i, r, r, NA_REAL, NA_REAL});
+        o.missing++;
+        continue;
+      }
+      if (v.size() > first && lat[v.back()] == lat[i] && lon[v.back()] == lon[i]) {
+        issues.push_back({ISSUE_DUPLICATE, v.back(), i, r, r, lat[i], lon[i]});
+        o.duplicates++;
+        continue;
+      }
+      v.push_back(i);
+      ring_of.push_back(q);
+    }
+    if (v.size() > first + 1 && lat[v.back()] == lat[v[first]] &&
+        lon[v.back()] == lon[v[first]]) {
+      v.pop_back();
+      ring_of.pop_back();
+    }
+    v_start.push_back(v.size());
+    o.n = static_cast<int>(v.size() - first);
+    PolygonArea poly(geod, false);
+    for (size_t k = first; k < v.size(); k++) poly.AddPoint(lat[v[k]], lon[v[k]]);
+    double perim;
+    poly.Compute(false, true, perim, o.area);
+  }
+
+  // Vertices repeated elsewhere in the polygon, found by sorting
+  size_t nv = v.size();
+  vector<size_t> byloc(nv);
+  for (size_t k = 0; k < nv; k++) byloc[k] = k;
+  sort(byloc.begin(), byloc.end(), [&](size_t a, size_t b) {
+    size_t ia = v[a], ib = v[b];
+    if (lat[ia] != lat[ib]) return lat[ia] < lat[ib];
+    if (lon[ia] != lon[ib]) return lon[ia] < lon[ib];
+    return a < b;
+  });
+  for (size_t k = 1; k < nv; k++) {
+    size_t a = v[byloc[k - 1]], b = v[byloc[k]];
+    if (lat[a] != lat[b] || lon[a] != lon[b]) continue;
+    size_t rb = rings[ring_of[byloc[k]]];
+    issues.push_back({ISSUE_DUPLICATE, a, b, rings[ring_of[byloc[k - 1]]], rb,
+                      lat[b], lon[b]});
+    out[rb].duplicates++;
+  }
+
+  // Edges: vertex k to the next vertex of its ring, for rings of at least 3
+  vector<size_t> ea, eb, eprev, ering;
+  for (size_t q = 0; q < nrings; q++) {
+    size_t m = v_start[q + 1] - v_start[q];
+    if (m < 3) continue;
+    size_t e0 = ea.size();
+    for (size_t k = 0; k < m; k++) {
+      ea.push_back(v[v_start[q] + k]);
+      eb.push_back(v[v_start[q] + (k + 1) % m]);
+      eprev.push_back(e0 + (k + m - 1) % m);
+      ering.push_back(q);
+    }
+  }
+  size_t ne = ea.size();
+  vector<geographiclib_r::segment_box> boxes;
+  vector<double> length, azi;
+  geographiclib_r::segment_boxes(geod, lat, lon, ea.data(), eb.data(), ne,
+                                 nthreads, boxes, length, &azi);
+  vector<size_t> box_start(ne + 1, 0);
+  for (const auto& b : boxes) box_start[b.seg + 1]++;
+  for (size_t e = 0; e < ne; e++) box_start[e + 1] += box_start[e];
+  vector<geographiclib_r::segment_box> indexed(boxes);
+  geographiclib_r::segment_index index;
+  index.build(indexed);
+
+  // Crossings of edges e < f, with the distances along each
+  struct hit { size_t e, f; double x, y, lat, lon; };
+  vector<hit> hits;
+  vector<size_t> cand;
+  // Edge a followed by edge b turns back on itself
+  auto doubles_back = [&](size_t a, size_t b) {
+    return fabs(Math::AngDiff(azi[2 * a + 1], azi[2 * b])) > Math::hd - 1e-9;
+  };
+  for (size_t e = 0; e < ne; e++) {
+    cand.clear();
+    for (size_t j = box_start[e]; j < box_start[e + 1]; j++)
+      index.query(boxes[j], [&](size_t f) { if (f > e) cand.push_back(f); });
+    if (cand.empty()) continue;
+    sort(cand.begin(), cand.end());
+    cand.erase(unique(cand.begin(), cand.end()), cand.end());
+    bool first = true;
+    GeodesicLine lineX;
+    for (size_t f : cand) {
+      if (eprev[f] == e || eprev[e] == f) {
+        size_t a = eprev[f] == e ? e : f, b = a == e ? f : e;
+        if (doubles_back(a, b))
+          hits.push_back({e, f, a == e ? length[e] : 0, a == e ? 0 : length[f],
+                          lat[ea[b]], lon[ea[b]]});
+        continue;
+      }
+      if (first) {
+        lineX = geod.InverseLine(lat[ea[e]], lon[ea[e]], lat[eb[e]], lon[eb[e]],
+                                 Intersect::LineCaps);
+        first = false;
+      }
+      GeodesicLine lineY = geod.InverseLine(lat[ea[f]], lon[ea[f]], lat[eb[f]], lon[eb[f]],
+                                            Intersect::LineCaps);
+      int segmode, coinc;
+      Intersect::Point p = inter.Segment(lineX, lineY, segmode, &coinc);
+      if (segmode != 0) {
+        if (!(p.first >= -tol && p.first <= length[e] + tol &&
+              p.second >= -tol && p.second <= length[f] + tol))
+          continue;
+        p.first = min(max(p.first, 0.0), length[e]);
+        p.second = min(max(p.second, 0.0), length[f]);
+      }
+      hit h{e, f, p.first, p.second, 0, 0};
+      lineX.Position(p.first, h.lat, h.lon);
+      hits.push_back(h);
+    }
+  }
+
+  // A crossing at a vertex is found on both edges that meet there; keep the
+  // one on the edge ending at the vertex
+  unordered_map<size_t, size_t> where;  // e * ne + f -> hit
+  for (size_t k = 0; k < hits.size(); k++)
+    where.emplace(hits[k].e * ne + hits[k].f, k);
+  // Is there a hit of edge a (at its end) with edge b?
+  auto ends = [&](size_t a, size_t b) {
+    if (a == b) return false;
+    auto it = a < b ? where.find(a * ne + b) : where.find(b * ne + a);
+    if (it == where.end()) return false;
+    const hit& q = hits[it->second];
+    return (a < b ? q.x : q.y) >= length[a] - tol;
+  };
+  for (const hit& h : hits) {
+    if (h.x <= tol && ends(eprev[h.e], h.f)) continue;
+    if (h.y <= tol && ends(eprev[h.f], h.e)) continue;
+    size_t r1 = rings[ering[h.e]], r2 = rings[ering[h.f]];
+    issues.push_back({ISSUE_CROSSING, ea[h.e], ea[h.f], r1, r2, h.lat, h.lon});
+    out[r1].crossings++;
+    if (r2 != r1) out[r2].crossings++;
+  }
+}
+
+// Check polygons given by id, with optional ring ids for holes; returns a
+// data frame of rings and one of issues
+[[cpp11::register]]
+cpp11::writable::list polygon_validity_cpp(cpp11::doubles lon, cpp11::doubles lat,
+                                           cpp11::integers id, cpp11::integers ring,
+                                           int nthreads) {
+  size_t nn = lon.size();
+  bool has_ring = ring.size() > 0;
+  polygon_groups g;
+  polygon_group(nn, INTEGER(id), nullptr, has_ring ? INTEGER(ring) : nullptr, g);
+  size_t nrings = g.ring_id.size(), npolys = g.feature_id.size();
+
+  // Rings of each polygon, in order
+  vector<size_t> poly_start(npolys + 1, 0), poly_rings(nrings);
+  for (size_t r = 0; r < nrings; r++) poly_start[g.part_feature[g.ring_part[r]] + 1]++;
+  for (size_t p = 0; p < npolys; p++) poly_start[p + 1] += poly_start[p];
+  {
+    vector<size_t> next(poly_start.begin(), poly_start.end() - 1);
+    for (size_t r = 0; r < nrings; r++)
+      poly_rings[next[g.part_feature[g.ring_part[r]]]++] = r;
+  }
+
+  // Blocks of consecutive polygons of about 16k vertices, one task each; a
+  // larger polygon is a block of its own
+  vector<size_t> blocks(1, 0);
+  size_t count = 0;
+  for (size_t p = 0; p < npolys; p++) {
+    for (size_t r = poly_start[p]; r < poly_start[p + 1]; r++) {
+      size_t q = poly_rings[r];
+      count += g.ring_start[q + 1] - g.ring_start[q];
+    }
+    if (count >= 16384) {
+      blocks.push_back(p + 1);
+      count = 0;
+    }
+  }
+  if (blocks.back() != npolys) blocks.push_back(npolys);
+  size_t nblocks = blocks.size() - 1;
+
+  vector<validity_ring> rings(nrings);
+  vector<vector<validity_issue>> issues(npolys);
+
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  const polygon_groups* pg = &g;
+  const size_t* pstart = poly_start.data();
+  const size_t* prings = poly_rings.data();
+  validity_ring* pout = rings.data();
+  vector<validity_issue>* pissues = issues.data();
+  const size_t* pblocks = blocks.data();
+  const Geodesic& geod = Geodesic::WGS84();
+  // A single block (e.g. one large polygon) uses the threads for its boxes
+  int inner = nblocks == 1 ? nthreads : 1;
+  geographiclib_r::parallel_tasks(nblocks, nthreads, [&](size_t b) {
+    Intersect inter(geod);
+    for (size_t p = pblocks[b]; p < pblocks[b + 1]; p++)
+      polygon_check(geod, inter, plat, plon, *pg, prings + pstart[p],
+                    pstart[p + 1] - pstart[p], pout, pissues[p], inner);
+  });
+
+  writable::integers r_id(nrings), r_ring(nrings), r_n(nrings),
+    r_dup(nrings), r_cross(nrings), r_miss(nrings);
+  writable::doubles r_area(nrings);
+  writable::logicals r_valid(nrings);
+  for (size_t r = 0; r < nrings; r++) {
+    const validity_ring& o = rings[poly_rings[r]];
+    size_t rr = poly_rings[r];
+    r_id[r] = g.feature_id[g.part_feature[g.ring_part[rr]]];
+    r_ring[r] = has_ring ? g.ring_id[rr] : 1;
+    r_n[r] = o.n;
+    r_area[r] = o.area;
+    r_dup[r] = o.duplicates;
+    r_cross[r] = o.crossings;
+    r_miss[r] = o.missing;
+    r_valid[r] = o.n >= 3 && o.duplicates == 0 && o.crossings == 0 && o.missing == 0;
+  }
+
+  size_t ni = 0;
+  for (const auto& v : issues) ni += v.size();
+  writable::integers i_id(ni), i_type(ni), i_row1(ni), i_row2(ni), i_ring1(ni), i_ring2(ni);
+  writable::doubles i_lat(ni), i_lon(ni);
+  size_t k = 0;
+  for (size_t p = 0; p < npolys; p++) {
+    for (const validity_issue& u : issues[p]) {
+      i_id[k] = g.feature_id[p];
+      i_type[k] = u.type;
+      i_row1[k] = static_cast<int>(u.row1 + 1);
+      i_row2[k] = static_cast<int>(u.row2 + 1);
+      i_ring1[k] = has_ring ? g.ring_id[u.ring1] : 1;
+      i_ring2[k] = has_ring ? g.ring_id[u.ring2] : 1;
+      i_lat[k] = u.lat;
+      i_lon[k] = u.lon;
+      k++;
+    }
+  }
+
+  writable::data_frame ring_df({
+    "id"_nm = r_id,
+      "ring"_nm = r_ring,
+      "n"_nm = r_n,
+      "area"_nm = r_area,
+      "duplicates"_nm = r_dup,
+      "crossings"_nm = r_cross,
+      "missing"_nm = r_miss,
+      "valid"_nm = r_valid
+  });
+  writable::data_frame issue_df({
+    "id"_nm = i_id,
+      "type"_nm = i_type,
+      "row1"_nm = i_row1,
+      "row2"_nm = i_row2,
+      "ring1"_nm = i_ring1,
+      "ring2"_nm = i_ring2,
+      "lat"_nm = i_lat,
+      "lon"_nm = i_lon
+  });
+
+  writable::list out({
+    "rings"_nm = ring_df,
+      "issues"_nm = issue_df
+  });
+
+  return out;
+}
@@ -0,0 +1,204 @@
+#include <cpp11.hpp>
+using namespace cpp11;
+namespace writable = cpp11::writable;
+
+#include <memory>
+#include <string>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/LambertConformalConic.hpp>
+#include <GeographicLib/AlbersEqualArea.hpp>
+#include <GeographicLib/PolarStereographic.hpp>
+#include "000_parallel_geographiclib.h"
+
+using namespace std;
+using namespace GeographicLib;
+
+// A projection constructed once, for any ellipsoid, and reused by many
+// calls.  The LCC and Albers constructors solve for the cone constant and
+// latitude of origin, so building them per call is not free.  Exactly one
+// of the pointers is set, according to type.
+struct projection_handle {
+  string type;
+  unique_ptr<TransverseMercator> tm;
+  unique_ptr<LambertConformalConic> lcc;
+  unique_ptr<AlbersEqualArea> albers;
+  unique_ptr<PolarStereographic> ps;
+};
+
+// Throws if the handle did not survive (e.g. it was restored from a saved
+// workspace); the R side rebuilds it from its parameters before getting here
+static const projection_handle& projection_get(SEXP proj_ptr) {
+  cpp11::external_pointer<projection_handle> ptr(proj_ptr);
+  if (ptr.get() == nullptr) {
+    cpp11::stop("projection is no longer valid; create it again with projection_create()");
+  }
+  return *ptr;
+}
+
+// Build a projection.  stdlat has one element (a single standard parallel
+// with scale k on it) or two (two standard parallels with scale k on the
+// first) for "lcc" and "albers", and is ignored otherwise; k is the central
+// scale for "tm" and "polarstereo".
+[[cpp11::register]]
+SEXP projection_create_cpp(std::string type, double a, double f,
+                           cpp11::doubles stdlat, double k, bool exact) {
+  unique_ptr<projection_handle> proj(new projection_handle);
+  proj->type = type;
+  if (type == "tm") {
+    proj->tm.reset(new TransverseMercator(a, f, k, exact));
+  } else if (type == "lcc" || type == "albers") {
+    if (stdlat.size() != 1 && stdlat.size() != 2)
+      cpp11::stop("'stdlat' must have one or two elements");
+    bool two = stdlat.size() == 2;
+    if (type == "lcc")
+      proj->lcc.reset(two ?
+                      new LambertConformalConic(a, f, stdlat[0], stdlat[1], k) :
+                      new LambertConformalConic(a, f, stdlat[0], k));
+    else
+      proj->albers.reset(two ?
+                         new AlbersEqualArea(a, f, stdlat[0], stdlat[1], k) :
+                         new AlbersEqualArea(a, f, stdlat[0], k));
+  } else if (type == "polarstereo") {
+    proj->ps.reset(new PolarStereographic(a, f, k));
+  } else {
+    cpp11::stop("unknown projection type '%s'", type.c_str());
+  }
+  cpp11::external_pointer<projection_handle> ptr(proj.release());
+  return ptr;
+}
+
+// Whether a handle still points at a projection
+[[cpp11::register]]
+bool projection_valid_cpp(SEXP proj_ptr) {
+  cpp11::external_pointer<projection_handle> ptr(proj_ptr);
+  return ptr.get() != nullptr;
+}
+
+// Parameters derived by the constructor: the latitude of origin and the
+// scale on it (for TM and polar stereographic, the central scale)
+[[cpp11::register]]
+cpp11::writable::list projection_info_cpp(SEXP proj_ptr) {
+  const projection_handle& proj = projection_get(proj_ptr);
+  double lat0 = 0, k0 = 1;
+  if (proj.tm) {
+    k0 = proj.tm->CentralScale();
+  } else if (proj.lcc) {
+    lat0 = proj.lcc->OriginLatitude();
+    k0 = proj.lcc->CentralScale();
+  } else if (proj.albers) {
+    lat0 = proj.albers->OriginLatitude();
+    k0 = proj.albers->CentralScale();
+  } else {
+    lat0 = 90;
+    k0 = proj.ps->CentralScale();
+  }
+  writable::list out({
+    "lat0"_nm = lat0,
+    "k0"_nm = k0
+  });
+  return out;
+}
+
+// Forward: Geographic (lon/lat) to projected (x/y).  lon0 (the central
+// meridian) is used by TM, LCC and Albers, northp (the hemisphere) by polar
+// stereographic; both have one element per point.
+[[cpp11::register]]
+cpp11::writable::data_frame projection_fwd_cpp(SEXP proj_ptr,
+                                               cpp11::doubles lon, cpp11::doubles lat,
+                                               cpp11::doubles lon0, cpp11::logicals northp,
+                                               int nthreads) {
+  const projection_handle& proj = projection_get(proj_ptr);
+  size_t nn = lon.size();
+
+  writable::doubles x(nn);
+  writable::doubles y(nn);
+  writable::doubles convergence(nn);
+  writable::doubles scale(nn);
+
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  const double* plon0 = REAL(lon0);
+  const int* pnorthp = LOGICAL(northp);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      if (proj.tm)
+        proj.tm->Forward(plon0[i], plat[i], plon[i],
+                         px[i], py[i], pconvergence[i], pscale[i]);
+      else if (proj.lcc)
+        proj.lcc->Forward(plon0[i], plat[i], plon[i],
+                          px[i], py[i], pconvergence[i], pscale[i]);
+      else if (proj.albers)
+        proj.albers->Forward(plon0[i], plat[i], plon[i],
+                             px[i], py[i], pconvergence[i], pscale[i]);
+      else
+        proj.ps->Forward(pnorthp[i] == TRUE, plat[i], plon[i],
+                         px[i], py[i], pconvergence[i], pscale[i]);
+    }
+  });
+
+  writable::data_frame out({
+    "x"_nm = x,
+    "y"_nm = y,
+    "convergence"_nm = convergence,
+    "scale"_nm = scale,
+    "lon"_nm = lon,
+    "lat"_nm = lat
+  });
+
+  return out;
+}
+
+// Reverse: projected (x/y) to Geographic (lon/lat)
+[[cpp11::register]]
+cpp11::writable::data_frame projection_rev_cpp(SEXP proj_ptr,
+                                               cpp11::doubles x, cpp11::doubles y,
+                                               cpp11::doubles lon0, cpp11::logicals northp,
+                                               int nthreads) {
+  const projection_handle& proj = projection_get(proj_ptr);
+  size_t nn = x.size();
+
+  writable::doubles lon(nn);
+  writable::doubles lat(nn);
+  writable::doubles convergence(nn);
+  writable::doubles scale(nn);
+
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  const double* plon0 = REAL(lon0);
+  const int* pnorthp = LOGICAL(northp);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      if (proj.tm)
+        proj.tm->Reverse(plon0[i], px[i], py[i],
+                         plat[i], plon[i], pconvergence[i], pscale[i]);
+      else if (proj.lcc)
+        proj.lcc->Reverse(plon0[i], px[i], py[i],
+                          plat[i], plon[i], pconvergence[i], pscale[i]);
+      else if (proj.albers)
+        proj.albers->Reverse(plon0[i], px[i], py[i],
+                             plat[i], plon[i], pconvergence[i], pscale[i]);
+      else
+        proj.ps->Reverse(pnorthp[i] == TRUE, px[i], py[i],
+                         plat[i], plon[i], pconvergence[i], pscale[i]);
+    }
+  });
+
+  writable::data_frame out({
+    "lon"_nm = lon,
+    "lat"_nm = lat,
+    "convergence"_nm = convergence,
+    "scale"_nm = scale,
+    "x"_nm = x,
+    "y"_nm = y
+  });
+
+  return out;
+}
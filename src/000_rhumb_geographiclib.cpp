@@ -4,6 +4,7 @@ namespace writable = cpp11::writable;
 
 #include <string>
 #include <GeographicLib/Rhumb.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -173,24 +174,28 @@ cpp11::writable::doubles rhumb_distance_pairwise_cpp(cpp11::doubles lon1, cpp11:
 }
 
 // Compute rhumb distance matrix between two sets of points
-// Returns a vector in row-major order (for reshaping to matrix in R)
+// Returns an n1 x n2 matrix; with symmetric = TRUE only the upper triangle
+// is solved, then mirrored.  Kept on one thread because Rhumb fills its
+// AuxLatitude series coefficients lazily, which is not thread safe.
 [[cpp11::register]]
 cpp11::writable::doubles rhumb_distance_matrix_cpp(cpp11::doubles lon1, cpp11::doubles lat1,
-                                                    cpp11::doubles lon2, cpp11::doubles lat2) {
+                                                    cpp11::doubles lon2, cpp11::doubles lat2,
+                                                    bool symmetric) {
   size_t n1 = lon1.size();
   size_t n2 = lon2.size();
   
   writable::doubles dist(n1 * n2);
+  double* out = REAL(dist);
   
   const Rhumb& rhumb = Rhumb::WGS84();
   
-  for (size_t i = 0; i < n1; i++) {
-    for (size_t j = 0; j < n2; j++) {
+  geographiclib_r::distance_matrix(n1, n2, symmetric && n1 == n2, 1, out,
+    [&](size_t i, size_t j) {
       double s12, azi12;
       rhumb.Inverse(lat1[i], lon1[i], lat2[j], lon2[j], s12, azi12);
-      dist[i * n2 + j] = s12;
-    }
-  }
+      return s12;
+    });
   
+  dist.attr("dim") = writable::integers({static_cast<int>(n1), static_cast<int>(n2)});
   return dist;
 }
@@ -0,0 +1,197 @@
+#ifndef GEOGRAPHICLIB_R_SEGINDEX_H
+#define GEOGRAPHICLIB_R_SEGINDEX_H
+
+// Bounding box index of geodesic segments.
+//
+// Each segment is the shortest geodesic between two vertices.  Its longitude
+// changes monotonically from one end to the other (by Clairaut's relation
+// the sign of the azimuth's sine is fixed), so its longitude range is the
+// one between its endpoints.  Its latitude is monotonic too, except where it
+// passes a vertex of the geodesic (azimuth +/-90 degrees), whose latitude
+// follows from Clairaut's relation; the latitude range is widened to include
+// it when the azimuth's cosine changes sign along the segment.  These boxes
+// are exact up to rounding and are padded slightly to cover that.
+//
+// The boxes are held in a packed R-tree (sort-tile-recursive, 16 entries a
+// node) built once; queries are const and may run on several threads at
+// once.  Only pairs of segments whose boxes overlap need be passed to
+// Intersect::Segment.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/Math.hpp>
+#include "000_parallel_geographiclib.h"
+
+namespace geographiclib_r {
+
+// A box on [-180, 180] in longitude; boxes across the antimeridian are
+// stored as two
+struct segment_box {
+  double lat0, lat1, lon0, lon1;
+  size_t seg;
+
+  bool overlaps(const segment_box& o) const {
+    return lat0 <= o.lat1 && o.lat0 <= lat1 && lon0 <= o.lon1 && o.lon0 <= lon1;
+  }
+  void extend(const segment_box& o) {
+    lat0 = std::min(lat0, o.lat0); lat1 = std::max(lat1, o.lat1);
+    lon0 = std::min(lon0, o.lon0); lon1 = std::max(lon1, o.lon1);
+  }
+};
+
+// Append the boxes of segment seg from (lat1, lon1) to (lat2, lon2), with
+// azimuths azi1 and azi2 at its ends from Geodesic::Inverse
+inline void segment_boxes(const GeographicLib::Geodesic& geod, size_t seg,
+                          double lat1, double lon1, double lat2, double lon2,
+                          double azi1, double azi2,
+                          std::vector<segment_box>& out) {
+  using GeographicLib::Math;
+  // About 1 mm; the extents are computed to within rounding
+  const double pad = 1e-8;
+  double latmin = std::min(lat1, lat2), latmax = std::max(lat1, lat2);
+  double salp1, calp1, salp2, calp2;
+  Math::sincosd(azi1, salp1, calp1);
+  Math::sincosd(azi2, salp2, calp2);
+  if ((calp1 > 0 && calp2 < 0) || (calp1 < 0 && calp2 > 0)) {
+    // The segment passes the vertex; with beta the parametric latitude,
+    // sin(alp0) = sin(alp1) cos(beta1) and the vertex is at beta = 90 - alp0
+    double f = geod.Flattening(), sphi, cphi;
+    Math::sincosd(lat1, sphi, cphi);
+    double sbet = (1 - f) * sphi, cbet = cphi;
+    Math::norm(sbet, cbet);
+    double salp0 = std::fabs(salp1 * cbet), calp0 = std::hypot(calp1, salp1 * sbet),
+      latv = Math::atan2d(calp0, (1 - f) * salp0);
+    if (calp1 > 0) latmax = std::max(latmax, latv);
+    else latmin = std::min(latmin, -latv);
+  }
+  segment_box b{std::max(latmin - pad, -double(Math::qd)),
+                std::min(latmax + pad, double(Math::qd)), 0, 0, seg};
+  if (std::fabs(lat1) == Math::qd || std::fabs(lat2) == Math::qd) {
+    // The longitude of a pole is arbitrary
+    b.lon0 = -Math::hd; b.lon1 = Math::hd;
+    out.push_back(b);
+    return;
+  }
+  double dlon = Math::AngDiff(lon1, lon2),
+    start = Math::AngNormalize(dlon >= 0 ? lon1 : lon2) - pad,
+    end = start + std::fabs(dlon) + 2 * pad;
+  if (start < -Math::hd) { start += Math::td; end += Math::td; }
+  b.lon0 = start;
+  b.lon1 = std::min(end, double(Math::hd));
+  out.push_back(b);
+  if (end > Math::hd) {
+    b.lon0 = -Math::hd;
+    b.lon1 = end - Math::td;
+    out.push_back(b);
+  }
+}
+
+// Boxes and lengths of the segments from row a[k] to row b[k] of lat and lon,
+// and if azi is not null, their azimuths at each end (2 k and 2 k + 1)
+inline void segment_boxes(const GeographicLib::Geodesic& geod,
+                          const double* lat, const double* lon,
+                          const size_t* a, const size_t* b, size_t nseg,
+                          int nthreads, std::vector<segment_box>& boxes,
+                          std::vector<double>& length,
+                          std::vector<double>* azi = nullptr) {
+  // At most two boxes a segment, gathered in order afterwards
+  std::vector<segment_box> two(2 * nseg);
+  std::vector<unsigned char> count(nseg);
+  length.resize(nseg);
+  segment_box* ptwo = two.data();
+  unsigned char* pcount = count.data();
+  double* plength = length.data();
+  if (azi) azi->resize(2 * nseg);
+  double* pazi = azi ? azi->data() : nullptr;
+  parallel_for(nseg, nthreads, [&](size_t k0, size_t k1) {
+    std::vector<segment_box> out;
+    for (size_t k = k0; k < k1; k++) {
+      double s12, azi1, azi2;
+      geod.Inverse(lat[a[k]], lon[a[k]], lat[b[k]], lon[b[k]], s12, azi1, azi2);
+      out.clear();
+      segment_boxes(geod, k, lat[a[k]], lon[a[k]], lat[b[k]], lon[b[k]],
+                    azi1, azi2, out);
+      pcount[k] = static_cast<unsigned char>(out.size());
+      std::copy(out.begin(), out.end(), ptwo + 2 * k);
+      plength[k] = s12;
+      if (pazi) { pazi[2 * k] = azi1; pazi[2 * k + 1] = azi2; }
+    }
+  });
+  boxes.clear();
+  boxes.reserve(nseg + nseg / 8);
+  for (size_t k = 0; k < nseg; k++)
+    boxes.insert(boxes.end(), two.begin() + 2 * k, two.begin() + 2 * k + count[k]);
+}
+
+class segment_index {
+public:
+  // Build the tree; the boxes are taken over and reordered
+  void build(std::vector<segment_box>& boxes) {
+    _levels.clear();
+    _leaves.swap(boxes);
+    size_t n = _leaves.size();
+    if (n == 0) return;
+    // Sort-tile-recursive: slabs by longitude, then runs by latitude
+    size_t nnodes = (n + node_ - 1) / node_,
+      nslabs = static_cast<size_t>(std::ceil(std::sqrt(double(nnodes)))),
+      slab = nslabs * node_;
+    std::sort(_leaves.begin(), _leaves.end(), [](const segment_box& a, const segment_box& b) {
+      return a.lon0 + a.lon1 < b.lon0 + b.lon1;
+    });
+    for (size_t s = 0; s < n; s += slab)
+      std::sort(_leaves.begin() + s, _leaves.begin() + std::min(n, s + slab),
+                [](const segment_box& a, const segment_box& b) {
+                  return a.lat0 + a.lat1 < b.lat0 + b.lat1;
+                });
+    // Upper levels group consecutive nodes of the level below; seg holds the
+    // first child and the children run to the next node's first child
+    const std::vector<segment_box>* below = &_leaves;
+    do {
+      std::vector<segment_box> level;
+      for (size_t k = 0; k < below->size(); k += node_) {
+        segment_box b = (*below)[k];
+        for (size_t j = k + 1; j < std::min(below->size(), k + node_); j++)
+          b.extend((*below)[j]);
+        b.seg = k;
+        level.push_back(b);
+      }
+      _levels.push_back(level);
+      below = &_levels.back();
+    } while (below->size() > 1);
+  }
+
+  // Call f(seg) for every box overlapping q; a segment stored as two boxes
+  // may be reported twice
+  template <class F>
+  void query(const segment_box& q, F&& f) const {
+    if (_leaves.empty()) return;
+    std::vector<std::pair<size_t, size_t>> stack;  // (level + 1, node); 0 for leaves
+    stack.emplace_back(_levels.size(), 0);
+    while (!stack.empty()) {
+      size_t lev = stack.back().first, k = stack.back().second;
+      stack.pop_back();
+      if (lev == 0) {
+        if (_leaves[k].overlaps(q)) f(_leaves[k].seg);
+        continue;
+      }
+      const std::vector<segment_box>& nodes = _levels[lev - 1];
+      if (!nodes[k].overlaps(q)) continue;
+      size_t first = nodes[k].seg,
+        last = k + 1 < nodes.size() ? nodes[k + 1].seg
+        : (lev == 1 ? _leaves.size() : _levels[lev - 2].size());
+      for (size_t j = first; j < last; j++) stack.emplace_back(lev - 1, j);
+    }
+  }
+
+private:
+  static constexpr size_t node_ = 16;
+  std::vector<segment_box> _leaves;
+  std::vector<std::vector<segment_box>> _levels;
+};
+
+} // namespace geographiclib_r
+
+#endif
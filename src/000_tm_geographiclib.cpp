@@ -5,6 +5,7 @@ namespace writable = cpp11::writable;
 #include <GeographicLib/TransverseMercator.hpp>
 #include <GeographicLib/TransverseMercatorExact.hpp>
 #include <GeographicLib/Constants.hpp>
+#include "000_parallel_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
@@ -13,7 +14,7 @@ using namespace GeographicLib;
 // Uses series approximation (fast, accurate to ~5 nm)
 [[cpp11::register]]
 cpp11::writable::data_frame tm_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                        cpp11::doubles lon0, double k0) {
+                                        cpp11::doubles lon0, double k0, int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -21,18 +22,21 @@ cpp11::writable::data_frame tm_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
   writable::doubles convergence(nn);
   writable::doubles scale(nn);
   
-  const TransverseMercator& tm = TransverseMercator::UTM();
-  
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    tm.Forward(lon0[i], lat[i], lon[i], xx, yy, gamma, k);
-    
-    // Apply custom scale factor
-    x[i] = xx * k0;
-    y[i] = yy * k0;
-    convergence[i] = gamma;
-    scale[i] = k * k0;
-  }
+  // Central scale k0 (building the projection is cheap; see
+  // projection_create() for reusing other ellipsoids)
+  const TransverseMercator tm(Constants::WGS84_a(), Constants::WGS84_f(), k0);
+  
+  const double* plon0 = REAL(lon0);
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++)
+      tm.Forward(plon0[i], plat[i], plon[i], px[i], py[i], pconvergence[i], pscale[i]);
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -50,7 +54,7 @@ cpp11::writable::data_frame tm_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
 // Reverse: Transverse Mercator (x/y) to Geographic (lon/lat)
 [[cpp11::register]]
 cpp11::writable::data_frame tm_rev_cpp(cpp11::doubles x, cpp11::doubles y,
-                                        cpp11::doubles lon0, double k0) {
+                                        cpp11::doubles lon0, double k0, int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -58,18 +62,21 @@ cpp11::writable::data_frame tm_rev_cpp(cpp11::doubles x, cpp11::doubles y,
   writable::doubles convergence(nn);
   writable::doubles scale(nn);
   
-  const TransverseMercator& tm = TransverseMercator::UTM();
-  
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    // Undo custom scale factor before reverse
-    tm.Reverse(lon0[i], x[i] / k0, y[i] / k0, la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k * k0;
-  }
+  // Central scale k0 (building the projection is cheap; see
+  // projection_create() for reusing other ellipsoids)
+  const TransverseMercator tm(Constants::WGS84_a(), Constants::WGS84_f(), k0);
+  
+  const double* plon0 = REAL(lon0);
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++)
+      tm.Reverse(plon0[i], px[i], py[i], plat[i], plon[i], pconvergence[i], pscale[i]);
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
@@ -88,7 +95,8 @@ cpp11::writable::data_frame tm_rev_cpp(cpp11::doubles x, cpp11::doubles y,
 // Uses exact formulation (slower, but accurate everywhere)
 [[cpp11::register]]
 cpp11::writable::data_frame tm_exact_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
-                                              cpp11::doubles lon0, double k0) {
+                                              cpp11::doubles lon0, double k0,
+                                              int nthreads) {
   size_t nn = lon.size();
   
   writable::doubles x(nn);
@@ -96,17 +104,26 @@ cpp11::writable::data_frame tm_exact_fwd_cpp(cpp11::doubles lon, cpp11::doubles
   writable::doubles convergence(nn);
   writable::doubles scale(nn);
   
-  const TransverseMercatorExact& tm = TransverseMercatorExact::UTM();
-  
-  for (size_t i = 0; i < nn; i++) {
-    double xx, yy, gamma, k;
-    tm.Forward(lon0[i], lat[i], lon[i], xx, yy, gamma, k);
-    
-    x[i] = xx * k0;
-    y[i] = yy * k0;
-    convergence[i] = gamma;
-    scale[i] = k * k0;
-  }
+  const TransverseMercatorExact tm(Constants::WGS84_a(), Constants::WGS84_f(), k0);
+  
+  const double* plon0 = REAL(lon0);
+  const double* plat = REAL(lat);
+  const double* plon = REAL(lon);
+  double* px = REAL(x);
+  double* py = REAL(y);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double xx, yy, gamma, k;
+      tm.Forward(plon0[i], plat[i], plon[i], xx, yy, gamma, k);
+      
+      px[i] = xx;
+      py[i] = yy;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "x"_nm = x,
@@ -124,7 +141,8 @@ cpp11::writable::data_frame tm_exact_fwd_cpp(cpp11::doubles lon, cpp11::doubles
 // Reverse: Transverse Mercator Exact (x/y) to Geographic (lon/lat)
 [[cpp11::register]]
 cpp11::writable::data_frame tm_exact_rev_cpp(cpp11::doubles x, cpp11::doubles y,
-                                              cpp11::doubles lon0, double k0) {
+                                              cpp11::doubles lon0, double k0,
+                                              int nthreads) {
   size_t nn = x.size();
   
   writable::doubles lon(nn);
@@ -132,17 +150,26 @@ cpp11::writable::data_frame tm_exact_rev_cpp(cpp11::doubles x, cpp11::doubles y,
   writable::doubles convergence(nn);
   writable::doubles scale(nn);
   
-  const TransverseMercatorExact& tm = TransverseMercatorExact::UTM();
-  
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    tm.Reverse(lon0[i], x[i] / k0, y[i] / k0, la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k * k0;
-  }
+  const TransverseMercatorExact tm(Constants::WGS84_a(), Constants::WGS84_f(), k0);
+  
+  const double* plon0 = REAL(lon0);
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  double* plon = REAL(lon);
+  double* plat = REAL(lat);
+  double* pconvergence = REAL(convergence);
+  double* pscale = REAL(scale);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+      tm.Reverse(plon0[i], px[i], py[i], la, lo, gamma, k);
+      
+      plon[i] = lo;
+      plat[i] = la;
+      pconvergence[i] = gamma;
+      pscale[i] = k;
+    }
+  });
   
   writable::data_frame out({
     "lon"_nm = lon,
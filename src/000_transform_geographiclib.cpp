@@ -0,0 +1,435 @@
+#include <cpp11.hpp>
+using namespace cpp11;
+namespace writable = cpp11::writable;
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/LambertConformalConic.hpp>
+#include <GeographicLib/AlbersEqualArea.hpp>
+#include <GeographicLib/PolarStereographic.hpp>
+#include <GeographicLib/LocalCartesian.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/OSGB.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include "000_parallel_geographiclib.h"
+
+using namespace std;
+using namespace GeographicLib;
+
+// Points are carried through a pipeline in chunks of this many, so the
+// intermediate coordinates of a chunk (two sets of three arrays) stay in L1
+static const size_t transform_chunk = 256;
+
+// One coordinate system of a pipeline.  fwd() converts geographic
+// coordinates (lon, lat, h) to the system's own (x, y, z) and rev() goes
+// back; the projections carry h through as z.  UTM is a transverse Mercator
+// and UPS a polar stereographic stage with the false easting and northing
+// of the zone, and the OSGB grid a transverse Mercator on the Airy
+// ellipsoid, so they use the same code as the other projections.
+struct transform_stage {
+  enum kind { GEOGRAPHIC, TM, LCC, ALBERS, POLARSTEREO,
+              LOCALCARTESIAN, GEOCENTRIC };
+  kind type;
+  double lon0 = 0, x0 = 0, y0 = 0;
+  bool northp = true;
+  unique_ptr<TransverseMercator> tm;
+  unique_ptr<LambertConformalConic> lcc;
+  unique_ptr<AlbersEqualArea> albers;
+  unique_ptr<PolarStereographic> ps;
+  unique_ptr<LocalCartesian> lc;
+  unique_ptr<Geocentric> earth;
+
+  // n is at most transform_chunk
+  void fwd(const double* lon, const double* lat, const double* h, size_t n,
+           double* x, double* y, double* z) const {
+    double gamma, k;
+    switch (type) {
+    case GEOGRAPHIC:
+      copy(lon, lon + n, x);
+      copy(lat, lat + n, y);
+      break;
+    case TM:
+      for (size_t i = 0; i < n; i++)
+        tm->Forward(lon0, lat[i], lon[i], x[i], y[i]);
+      break;
+    case LCC:
+      for (size_t i = 0; i < n; i++)
+        lcc->Forward(lon0, lat[i], lon[i], x[i], y[i], gamma, k);
+      break;
+    case ALBERS:
+      for (size_t i = 0; i < n; i++)
+        albers->Forward(lon0, lat[i], lon[i], x[i], y[i], gamma, k);
+      break;
+    case POLARSTEREO:
+      for (size_t i = 0; i < n; i++)
+        ps->Forward(northp, lat[i], lon[i], x[i], y[i], gamma, k);
+      break;
+    case LOCALCARTESIAN:
+      lc->Forward(lat, lon, h, n, x, y, z);
+      return;
+    case GEOCENTRIC:
+      earth->Forward(lat, lon, h, n, x, y, z);
+      return;
+    }
+    copy(h, h + n, z);
+    if (x0 != 0 || y0 != 0) {
+      for (size_t i = 0; i < n; i++) {
+        x[i] += x0;
+        y[i] += y0;
+      }
+    }
+  }
+
+  // rev() may overwrite x and y (removing the false easting and northing)
+  void rev(double* x, double* y, const double* z, size_t n,
+           double* lon, double* lat, double* h) const {
+    double gamma, k;
+    if (x0 != 0 || y0 != 0) {
+      for (size_t i = 0; i < n; i++) {
+        x[i] -= x0;
+        y[i] -= y0;
+      }
+    }
+    switch (type) {
+    case GEOGRAPHIC:
+      copy(x, x + n, lon);
+      copy(y, y + n, lat);
+      break;
+    case TM:
+      for (size_t i = 0; i < n; i++)
+        tm->Reverse(lon0, x[i], y[i], lat[i], lon[i]);
+      break;
+    case LCC:
+      for (size_t i = 0; i < n; i++)
+        lcc->Reverse(lon0, x[i], y[i], lat[i], lon[i], gamma, k);
+      break;
+    case ALBERS:
+      for (size_t i = 0; i < n; i++)
+        albers->Reverse(lon0, x[i], y[i], lat[i], lon[i], gamma, k);
+      break;
+    case POLARSTEREO:
+      for (size_t i = 0; i < n; i++)
+        ps->Reverse(northp, x[i], y[i], lat[i], lon[i], gamma, k);
+      break;
+    case LOCALCARTESIAN:
+      lc->Reverse(x, y, z, n, lat, lon, h);
+      return;
+    case GEOCENTRIC:
+      earth->Reverse(x, y, z, n, lat, lon, h);
+      return;
+    }
+    copy(z, z + n, h);
+  }
+};
+
+typedef vector<unique_ptr<transform_stage>> transform_pipeline;
+
+// Throws if the handle did not survive (e.g. it was restored from a saved
+// workspace); the R side rebuilds it from its stages before getting here
+static const transform_pipeline& transform_get(SEXP tr_ptr) {
+  cpp11::external_pointer<transform_pipeline> ptr(tr_ptr);
+  if (ptr.get() == nullptr) {
+    cpp11::stop("transform is no longer valid; create it again with transform_create()");
+  }
+  return *ptr;
+}
+
+// Take m <= transform_chunk points, in place, from the first system of a
+// pipeline to the last.  For each pair of consecutive stages the points go
+// back to geographic and forward into the next system, between the caller's
+// buffers and a set of geographic ones on the stack.
+static void transform_run(const transform_pipeline& tr,
+                          double* x, double* y, double* z, size_t m) {
+  double lon[transform_chunk], lat[transform_chunk], h[transform_chunk];
+  for (size_t s = 1; s < tr.size(); s++) {
+    tr[s - 1]->rev(x, y, z, m, lon, lat, h);
+    tr[s]->fwd(lon, lat, h, m, x, y, z);
+  }
+}
+
+// Build a pipeline from its stages, one element of each argument per stage.
+// stdlat2 is NA for LCC and Albers with a single standard parallel; zone is
+// the UTM zone for "utmups" (0 for UPS), with northp the hemisphere.
+[[cpp11::register]]
+SEXP transform_create_cpp(cpp11::strings type, cpp11::doubles a, cpp11::doubles f,
+                          cpp11::doubles lat0, cpp11::doubles lon0, cpp11::doubles h0,
+                          cpp11::doubles stdlat1, cpp11::doubles stdlat2,
+                          cpp11::doubles k0, cpp11::integers zone,
+                          cpp11::logicals northp, cpp11::logicals exact) {
+  unique_ptr<transform_pipeline> tr(new transform_pipeline);
+  for (R_xlen_t s = 0; s < type.size(); s++) {
+    string t = type[s];
+    unique_ptr<transform_stage> st(new transform_stage);
+    st->lon0 = lon0[s];
+    st->northp = northp[s] == TRUE;
+    if (t == "geographic") {
+      st->type = transform_stage::GEOGRAPHIC;
+    } else if (t == "utmups") {
+      int z = zone[s];
+      if (z == NA_INTEGER || z < UTMUPS::MINZONE || z > UTMUPS::MAXZONE)
+        cpp11::stop("'zone' must be 0 (UPS) or a UTM zone from 1 to 60");
+      if (z == UTMUPS::UPS) {
+        st->type = transform_stage::POLARSTEREO;
+        st->ps.reset(new PolarStereographic(PolarStereographic::UPS()));
+        st->x0 = st->y0 = 2000000;
+      } else {
+        st->type = transform_stage::TM;
+        st->tm.reset(new TransverseMercator(TransverseMercator::UTM()));
+        st->lon0 = 6.0 * z - 183;
+        st->x0 = 500000;
+        st->y0 = st->northp ? 0 : 10000000;
+      }
+    } else if (t == "tm") {
+      st->type = transform_stage::TM;
+      st->tm.reset(new TransverseMercator(a[s], f[s], k0[s], exact[s] == TRUE));
+    } else if (t == "lcc" || t == "albers") {
+      bool two = !ISNAN(stdlat2[s]);
+      if (t == "lcc") {
+        st->type = transform_stage::LCC;
+        st->lcc.reset(two ?
+                      new LambertConformalConic(a[s], f[s], stdlat1[s], stdlat2[s], k0[s]) :
+                      new LambertConformalConic(a[s], f[s], stdlat1[s], k0[s]));
+      } else {
+        st->type = transform_stage::ALBERS;
+        st->albers.reset(two ?
+                         new AlbersEqualArea(a[s], f[s], stdlat1[s], stdlat2[s], k0[s]) :
+                         new AlbersEqualArea(a[s], f[s], stdlat1[s], k0[s]));
+      }
+    } else if (t == "polarstereo") {
+      st->type = transform_stage::POLARSTEREO;
+      st->ps.reset(new PolarStereographic(a[s], f[s], k0[s]));
+    } else if (t == "localcartesian") {
+      st->type = transform_stage::LOCALCARTESIAN;
+      st->lc.reset(new LocalCartesian(lat0[s], lon0[s], h0[s], Geocentric(a[s], f[s])));
+    } else if (t == "geocentric") {
+      st->type = transform_stage::GEOCENTRIC;
+      st->earth.reset(new Geocentric(a[s], f[s]));
+    } else if (t == "osgb") {
+      // As OSGB::Forward, with the northing of the origin found once here
+      // rather than for every chunk
+      double x, y;
+      st->type = transform_stage::TM;
+      st->tm.reset(new TransverseMercator(OSGB::EquatorialRadius(), OSGB::Flattening(),
+                                          OSGB::CentralScale()));
+      st->lon0 = OSGB::OriginLongitude();
+      st->tm->Forward(st->lon0, OSGB::OriginLatitude(), st->lon0, x, y);
+      st->x0 = OSGB::FalseEasting();
+      st->y0 = OSGB::FalseNorthing() - y;
+    } else {
+      cpp11::stop("unknown coordinate system '%s'", t.c_str());
+    }
+    tr->push_back(std::move(st));
+  }
+  if (tr->size() < 2) cpp11::stop("a transform needs at least two coordinate systems");
+  cpp11::external_pointer<transform_pipeline> ptr(tr.release());
+  return ptr;
+}
+
+// Whether a handle still points at a pipeline
+[[cpp11::register]]
+bool transform_valid_cpp(SEXP tr_ptr) {
+  cpp11::external_pointer<transform_pipeline> ptr(tr_ptr);
+  return ptr.get() != nullptr;
+}
+
+// Apply a pipeline: (x, y, z) in the first system to the last, a chunk at
+// a time, writing out only the final coordinates.
+[[cpp11::register]]
+cpp11::writable::data_frame transform_apply_cpp(SEXP tr_ptr,
+                                                cpp11::doubles x, cpp11::doubles y,
+                                                cpp11::doubles z, int nthreads) {
+  const transform_pipeline& tr = transform_get(tr_ptr);
+  size_t nn = x.size();
+
+  writable::doubles xout(nn);
+  writable::doubles yout(nn);
+  writable::doubles zout(nn);
+
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  const double* pz = REAL(z);
+  double* pxout = REAL(xout);
+  double* pyout = REAL(yout);
+  double* pzout = REAL(zout);
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    double bx[transform_chunk], by[transform_chunk], bz[transform_chunk];
+    for (size_t j0 = i0; j0 < i1; j0 += transform_chunk) {
+      size_t m = min(transform_chunk, i1 - j0);
+      copy(px + j0, px + j0 + m, bx);
+      copy(py + j0, py + j0 + m, by);
+      copy(pz + j0, pz + j0 + m, bz);
+      transform_run(tr, bx, by, bz, m);
+      copy(bx, bx + m, pxout + j0);
+      copy(by, by + m, pyout + j0);
+      copy(bz, bz + m, pzout + j0);
+    }
+  });
+
+  writable::data_frame out({
+    "x"_nm = xout,
+    "y"_nm = yout,
+    "z"_nm = zout
+  });
+
+  return out;
+}
+
+// Coordinates of the pixel centers of one row of a grid in the last system of
+// a pipeline, following GDAL's approximate transformer.  A segment of the
+// row is interpolated from exact values at its knots (its ends, plus two
+// interior pixels for cubic interpolation) and the interpolation is accepted
+// when it is within tol of the exact value at the middle pixel; otherwise
+// the segment is split there and both halves are tried again.  The exact
+// values needed by all the segments of a round are computed together, a
+// chunk at a time.  Segments too short to test are computed exactly.
+//
+// tol is in meters; for geographic output the differences in longitude and
+// latitude are converted to meters on a sphere.
+static void transform_grid_row(const transform_pipeline& tr,
+                               double x0, double dx, double yrow, size_t ncol,
+                               size_t step, bool cubic, double tol,
+                               double* ox, double* oy, double* oz) {
+  const bool geographic = tr.back()->type == transform_stage::GEOGRAPHIC;
+  const double degree = Math::pi() / Math::hd, mperdeg = 6371008.8 * degree;
+  // Shortest segment with a middle pixel distinct from its knots
+  const size_t shortest = cubic ? 4 : 2;
+  // 0 not yet computed, 1 requested or exact, 2 interpolated
+  vector<char> state(ncol, 0);
+  vector<size_t> want;
+  vector<pair<size_t, size_t>> segs, next;
+
+  auto need = [&](size_t i) {
+    if (state[i] == 0) {
+      state[i] = 1;
+      want.push_back(i);
+    }
+  };
+  // Cubic knots: the ends and the pixels about a third of the way in
+  auto knots = [&](size_t i0, size_t i1, size_t k[4]) {
+    size_t third = (i1 - i0) / 3;
+    k[0] = i0; k[1] = i0 + third; k[2] = i1 - third; k[3] = i1;
+  };
+  auto interp = [&](const double* v, size_t i0, size_t i1, size_t i) {
+    if (!cubic) {
+      double t = double(i - i0) / double(i1 - i0);
+      return v[i0] + t * (v[i1] - v[i0]);
+    }
+    size_t k[4];
+    knots(i0, i1, k);
+    double r = 0;
+    for (int a = 0; a < 4; a++) {
+      double l = v[k[a]];
+      for (int b = 0; b < 4; b++)
+        if (b != a) l *= (double(i) - double(k[b])) / (double(k[a]) - double(k[b]));
+      r += l;
+    }
+    return r;
+  };
+
+  if (ncol == 1) need(0);
+  for (size_t i0 = 0; i0 + 1 < ncol; i0 += step)
+    segs.emplace_back(i0, min(i0 + step, ncol - 1));
+
+  while (!segs.empty() || !want.empty()) {
+    for (const auto& sg : segs) {
+      size_t i0 = sg.first, i1 = sg.second;
+      if (i1 - i0 < shortest) {
+        for (size_t i = i0; i <= i1; i++) need(i);
+      } else if (cubic) {
+        size_t k[4];
+        knots(i0, i1, k);
+        for (int a = 0; a < 4; a++) need(k[a]);
+        need((i0 + i1) / 2);
+      } else {
+        need(i0); need(i1); need((i0 + i1) / 2);
+      }
+    }
+
+    double bx[transform_chunk], by[transform_chunk], bz[transform_chunk];
+    for (size_t j0 = 0; j0 < want.size(); j0 += transform_chunk) {
+      size_t m = min(transform_chunk, want.size() - j0);
+      for (size_t j = 0; j < m; j++) {
+        bx[j] = x0 + (double(want[j0 + j]) + 0.5) * dx;
+        by[j] = yrow;
+        bz[j] = 0;
+      }
+      transform_run(tr, bx, by, bz, m);
+      for (size_t j = 0; j < m; j++) {
+        size_t i = want[j0 + j];
+        ox[i] = bx[j]; oy[i] = by[j]; oz[i] = bz[j];
+      }
+    }
+    want.clear();
+
+    next.clear();
+    for (const auto& sg : segs) {
+      size_t i0 = sg.first, i1 = sg.second, mid = (i0 + i1) / 2;
+      if (i1 - i0 < shortest) continue;
+      double ex = interp(ox, i0, i1, mid) - ox[mid],
+        ey = interp(oy, i0, i1, mid) - oy[mid],
+        ez = interp(oz, i0, i1, mid) - oz[mid];
+      if (geographic) {
+        ex *= cos(oy[mid] * degree) * mperdeg;
+        ey *= mperdeg;
+      }
+      // Fails for NaN too, so points outside a projection end up exact
+      if (sqrt(ex * ex + ey * ey + ez * ez) <= tol) {
+        for (size_t i = i0 + 1; i < i1; i++) {
+          if (state[i] != 0) continue;
+          ox[i] = interp(ox, i0, i1, i);
+          oy[i] = interp(oy, i0, i1, i);
+          oz[i] = interp(oz, i0, i1, i);
+          state[i] = 2;
+        }
+      } else {
+        next.emplace_back(i0, mid);
+        next.emplace_back(mid, i1);
+      }
+    }
+    swap(segs, next);
+  }
+}
+
+// Apply a pipeline to the pixel centers of a grid in its first system, with
+// extent (xmin, xmax, ymin, ymax) and dimension (ncol, nrow).  Pixels are in
+// raster order, from the top left along rows.  step is the spacing of the
+// initial knots along a row; tolerance <= 0 computes every pixel exactly.
+[[cpp11::register]]
+cpp11::writable::data_frame transform_grid_cpp(SEXP tr_ptr, cpp11::doubles extent,
+                                               cpp11::integers dimension,
+                                               double tolerance, bool cubic,
+                                               int step, int nthreads) {
+  const transform_pipeline& tr = transform_get(tr_ptr);
+  size_t ncol = dimension[0], nrow = dimension[1];
+  size_t nn = ncol * nrow;
+  double xmin = extent[0], xmax = extent[1], ymin = extent[2], ymax = extent[3];
+  double dx = (xmax - xmin) / double(ncol), dy = (ymax - ymin) / double(nrow);
+
+  writable::doubles xout(nn);
+  writable::doubles yout(nn);
+  writable::doubles zout(nn);
+
+  double* pxout = REAL(xout);
+  double* pyout = REAL(yout);
+  double* pzout = REAL(zout);
+  if (tolerance <= 0) step = 1;
+  size_t knot = static_cast<size_t>(max(step, 1));
+  geographiclib_r::parallel_tasks(nrow, nthreads, [&](size_t r) {
+    transform_grid_row(tr, xmin, dx, ymax - (double(r) + 0.5) * dy, ncol,
+                       knot, cubic, tolerance,
+                       pxout + r * ncol, pyout + r * ncol, pzout + r * ncol);
+  });
+
+  writable::data_frame out({
+    "x"_nm = xout,
+    "y"_nm = yout,
+    "z"_nm = zout
+  });
+
+  return out;
+}
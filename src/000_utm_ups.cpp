@@ -2,117 +2,187 @@
 using namespace cpp11;
 namespace writable = cpp11::writable;
 
+#include <cmath>
 #include <string>
+#include <vector>
 #include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/PolarStereographic.hpp>
+#include <GeographicLib/Utility.hpp>
+#include "000_parallel_geographiclib.h"
+#include "000_utmups_geographiclib.h"
 
 using namespace std;
 using namespace GeographicLib;
+using geographiclib_r::nkeys;
+using geographiclib_r::utmups_crs_column;
+using geographiclib_r::utmups_key;
+using geographiclib_r::utmups_wants;
 
 // Forward: Geographic (lon/lat) to UTM/UPS (x/y)
+//
+// The points are binned by zone and hemisphere with a counting sort and each
+// bin is run through TransverseMercator::UTM() (or PolarStereographic::UPS())
+// with its central meridian and false origin fixed.  This matches
+// UTMUPS::Forward point for point; its range checks are left out because a
+// point in its standard zone always passes them.  Only the columns named in
+// `columns` are computed and returned.
 [[cpp11::register]]
-cpp11::writable::data_frame utmups_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat) {
+cpp11::writable::data_frame utmups_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat,
+                                           cpp11::strings columns, std::string crs,
+                                           int nthreads) {
   size_t nn = lon.size();
-  
-  writable::doubles x(nn);
-  writable::doubles y(nn);
-  writable::integers zone(nn);
-  writable::logicals northp(nn);
-  writable::doubles convergence(nn);
-  writable::doubles scale(nn);
-  writable::strings crs(nn);
-  
-  for (size_t i = 0; i < nn; i++) {
-    int z;
-    bool np;
-    double xx, yy, gamma, k;
-    
-    // Forward to UTM/UPS with convergence and scale
-    UTMUPS::Forward(lat[i], lon[i], z, np, xx, yy, gamma, k);
-    
-    x[i] = xx;
-    y[i] = yy;
-    zone[i] = z;
-    northp[i] = np;
-    convergence[i] = gamma;
-    scale[i] = k;
-    
-    // Build CRS string
-    string crs_str;
-    if (z == 0) {
-      // Polar zones: UPS North (32661) or UPS South (32761)
-      crs_str = np ? "EPSG:32661" : "EPSG:32761";
-    } else {
-      // Standard UTM zones: EPSG:326XX (north) or EPSG:327XX (south)
-      int hemi_code = np ? 6 : 7;
-      crs_str = "EPSG:32" + to_string(hemi_code) + (z < 10 ? "0" : "") + to_string(z);
+  bool want_x = utmups_wants(columns, "x"), want_y = utmups_wants(columns, "y");
+  bool want_gamma = utmups_wants(columns, "convergence");
+  bool want_k = utmups_wants(columns, "scale");
+  bool want_zone = utmups_wants(columns, "zone");
+  bool want_northp = utmups_wants(columns, "northp");
+
+  writable::doubles x(want_x ? nn : 0);
+  writable::doubles y(want_y ? nn : 0);
+  writable::doubles convergence(want_gamma ? nn : 0);
+  writable::doubles scale(want_k ? nn : 0);
+  writable::integers zone(want_zone ? nn : 0);
+  writable::logicals northp(want_northp ? nn : 0);
+  vector<int> key(nn);
+  vector<size_t> order(nn);
+
+  const double* plon = REAL(lon);
+  const double* plat = REAL(lat);
+  double* px = want_x ? REAL(x) : nullptr;
+  double* py = want_y ? REAL(y) : nullptr;
+  double* pconvergence = want_gamma ? REAL(convergence) : nullptr;
+  double* pscale = want_k ? REAL(scale) : nullptr;
+  int* pzone = want_zone ? INTEGER(zone) : nullptr;
+  int* pnorthp = want_northp ? LOGICAL(northp) : nullptr;
+  int* pkey = key.data();
+
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      if (fabs(plat[i]) > Math::qd)
+        throw GeographicErr("Latitude " + Utility::str(plat[i])
+                            + "d not in [-" + to_string(Math::qd)
+                            + "d, " + to_string(Math::qd) + "d]");
+      int z = UTMUPS::StandardZone(plat[i], plon[i]);
+      bool np = !signbit(plat[i]);
+      bool valid = z != UTMUPS::INVALID;
+      if (pzone) pzone[i] = valid ? z : NA_INTEGER;
+      if (pnorthp) pnorthp[i] = valid ? (np ? TRUE : FALSE) : NA_LOGICAL;
+      pkey[i] = utmups_key(z, np);
+    }
+  });
+
+  // Counting sort: the points with key kk are order[start[kk] .. start[kk+1])
+  vector<size_t> start(nkeys + 3, 0);
+  for (size_t i = 0; i < nn; i++) start[key[i] + 2]++;
+  for (int kk = 2; kk <= nkeys + 2; kk++) start[kk] += start[kk - 1];
+  for (size_t i = 0; i < nn; i++) order[start[key[i] + 1]++] = i;
+  const size_t* porder = order.data();
+
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t j0, size_t j1) {
+    for (size_t j = j0; j < j1;) {
+      int kk = pkey[porder[j]];
+      size_t jend = min(j1, start[kk + 1]);
+      int z = kk / 2;
+      bool np = kk % 2 == 1;
+      double x0, y0, lon0 = 6.0 * z - 183;
+      const TransverseMercator& tm = TransverseMercator::UTM();
+      const PolarStereographic& ps = PolarStereographic::UPS();
+      if (z == UTMUPS::UPS) {
+        x0 = y0 = 2000000;
+      } else {
+        x0 = 500000;
+        y0 = np ? 0 : 10000000;
+      }
+      for (; j < jend; j++) {
+        size_t i = porder[j];
+        double xx, yy, gamma, k;
+        if (kk == nkeys) {
+          xx = yy = gamma = k = Math::NaN();
+        } else {
+          if (z == UTMUPS::UPS)
+            ps.Forward(np, plat[i], plon[i], xx, yy, gamma, k);
+          else
+            tm.Forward(lon0, plat[i], plon[i], xx, yy, gamma, k);
+          xx += x0;
+          yy += y0;
+        }
+        if (px) px[i] = xx;
+        if (py) py[i] = yy;
+        if (pconvergence) pconvergence[i] = gamma;
+        if (pscale) pscale[i] = k;
+      }
     }
-    crs[i] = crs_str;
-  }
-  
-  writable::data_frame out({
-    "x"_nm = x,
-    "y"_nm = y,
-    "zone"_nm = zone,
-    "northp"_nm = northp,
-    "convergence"_nm = convergence,
-    "scale"_nm = scale,
-    "lon"_nm = lon,
-    "lat"_nm = lat,
-    "crs"_nm = crs
   });
-  
-  return out;
+
+  writable::list out;
+  if (want_x) out.push_back("x"_nm = x);
+  if (want_y) out.push_back("y"_nm = y);
+  if (want_zone) out.push_back("zone"_nm = zone);
+  if (want_northp) out.push_back("northp"_nm = northp);
+  if (want_gamma) out.push_back("convergence"_nm = convergence);
+  if (want_k) out.push_back("scale"_nm = scale);
+  if (utmups_wants(columns, "lon")) out.push_back("lon"_nm = lon);
+  if (utmups_wants(columns, "lat")) out.push_back("lat"_nm = lat);
+  if (utmups_wants(columns, "crs")) out.push_back("crs"_nm = utmups_crs_column(key, crs));
+
+  return writable::data_frame(out);
 }
 
 // Reverse: UTM/UPS (x/y/zone/northp) to Geographic (lon/lat)
 [[cpp11::register]]
-cpp11::writable::data_frame utmups_rev_cpp(cpp11::doubles x, cpp11::doubles y, 
-                                            cpp11::integers zone, cpp11::logicals northp) {
+cpp11::writable::data_frame utmups_rev_cpp(cpp11::doubles x, cpp11::doubles y,
+                                            cpp11::integers zone, cpp11::logicals northp,
+                                            cpp11::strings columns, std::string crs,
+                                            int nthreads) {
   size_t nn = x.size();
-  
-  writable::doubles lon(nn);
-  writable::doubles lat(nn);
-  writable::doubles convergence(nn);
-  writable::doubles scale(nn);
-  writable::strings crs(nn);
-  
-  for (size_t i = 0; i < nn; i++) {
-    double la, lo, gamma, k;
-    int z = zone[i];
-    bool np = northp[i];
-    
-    // Reverse to geographic with convergence and scale
-    UTMUPS::Reverse(z, np, x[i], y[i], la, lo, gamma, k);
-    
-    lon[i] = lo;
-    lat[i] = la;
-    convergence[i] = gamma;
-    scale[i] = k;
-    
-    // Build CRS string
-    string crs_str;
-    if (z == 0) {
-      // Polar zones: UPS North (32661) or UPS South (32761)
-      crs_str = np ? "EPSG:32661" : "EPSG:32761";
-    } else {
-      // Standard UTM zones: EPSG:326XX (north) or EPSG:327XX (south)
-      int hemi_code = np ? 6 : 7;
-      crs_str = "EPSG:32" + to_string(hemi_code) + (z < 10 ? "0" : "") + to_string(z);
+  bool want_lon = utmups_wants(columns, "lon"), want_lat = utmups_wants(columns, "lat");
+  bool want_gamma = utmups_wants(columns, "convergence");
+  bool want_k = utmups_wants(columns, "scale");
+
+  writable::doubles lon(want_lon ? nn : 0);
+  writable::doubles lat(want_lat ? nn : 0);
+  writable::doubles convergence(want_gamma ? nn : 0);
+  writable::doubles scale(want_k ? nn : 0);
+
+  const double* px = REAL(x);
+  const double* py = REAL(y);
+  const int* pzone = INTEGER(zone);
+  const int* pnorthp = LOGICAL(northp);
+  double* plon = want_lon ? REAL(lon) : nullptr;
+  double* plat = want_lat ? REAL(lat) : nullptr;
+  double* pconvergence = want_gamma ? REAL(convergence) : nullptr;
+  double* pscale = want_k ? REAL(scale) : nullptr;
+  geographiclib_r::parallel_for(nn, nthreads, [&](size_t i0, size_t i1) {
+    for (size_t i = i0; i < i1; i++) {
+      double la, lo, gamma, k;
+
+      // Reverse to geographic with convergence and scale (this also checks
+      // that the coordinates lie in the zone)
+      UTMUPS::Reverse(pzone[i] == NA_INTEGER ? int(UTMUPS::INVALID) : pzone[i],
+                      pnorthp[i] == TRUE, px[i], py[i], la, lo, gamma, k);
+
+      if (plon) plon[i] = lo;
+      if (plat) plat[i] = la;
+      if (pconvergence) pconvergence[i] = gamma;
+      if (pscale) pscale[i] = k;
     }
-    crs[i] = crs_str;
-  }
-  
-  writable::data_frame out({
-    "lon"_nm = lon,
-    "lat"_nm = lat,
-    "x"_nm = x,
-    "y"_nm = y,
-    "zone"_nm = zone,
-    "northp"_nm = northp,
-    "convergence"_nm = convergence,
-    "scale"_nm = scale,
-    "crs"_nm = crs
   });
-  
-  return out;
-}
\ No newline at end of file
+
+  writable::list out;
+  if (want_lon) out.push_back("lon"_nm = lon);
+  if (want_lat) out.push_back("lat"_nm = lat);
+  if (utmups_wants(columns, "x")) out.push_back("x"_nm = x);
+  if (utmups_wants(columns, "y")) out.push_back("y"_nm = y);
+  if (utmups_wants(columns, "zone")) out.push_back("zone"_nm = zone);
+  if (utmups_wants(columns, "northp")) out.push_back("northp"_nm = northp);
+  if (want_gamma) out.push_back("convergence"_nm = convergence);
+  if (want_k) out.push_back("scale"_nm = scale);
+  if (utmups_wants(columns, "crs")) {
+    vector<int> key(nn);
+    for (size_t i = 0; i < nn; i++) key[i] = utmups_key(pzone[i], pnorthp[i] == TRUE);
+    out.push_back("crs"_nm = utmups_crs_column(key, crs));
+  }
+
+  return writable::data_frame(out);
+}
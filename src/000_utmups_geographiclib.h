@@ -0,0 +1,85 @@
+#ifndef GEOGRAPHICLIB_R_UTMUPS_H
+#define GEOGRAPHICLIB_R_UTMUPS_H
+
+// Zone keys and CRS columns shared by the UTM/UPS and MGRS wrappers.
+//
+// These build R objects, so they are for the main thread only.
+
+#include <cpp11.hpp>
+#include <string>
+#include <vector>
+#include <GeographicLib/UTMUPS.hpp>
+
+namespace geographiclib_r {
+
+// Points are keyed by zone and hemisphere, 2 * zone + northp for zones 0
+// (UPS) to 60; points with an invalid zone get the key nkeys
+const int nkeys = 2 * (GeographicLib::UTMUPS::MAXZONE + 1);
+
+inline int utmups_key(int z, bool np) {
+  return z >= GeographicLib::UTMUPS::MINZONE && z <= GeographicLib::UTMUPS::MAXZONE ? 2 * z + (np ? 1 : 0) :
+    nkeys;
+}
+
+// CRS string for a UTM/UPS zone
+inline std::string utmups_crs(int z, bool np) {
+  if (z == 0) {
+    // Polar zones: UPS North (32661) or UPS South (32761)
+    return np ? "EPSG:32661" : "EPSG:32761";
+  }
+  // Standard UTM zones: EPSG:326XX (north) or EPSG:327XX (south)
+  int hemi_code = np ? 6 : 7;
+  return "EPSG:32" + std::to_string(hemi_code) + (z < 10 ? "0" : "") + std::to_string(z);
+}
+
+// The crs column for points with the given keys.  type is "string" (e.g.
+// "EPSG:32755"), "epsg" (the integer code) or "factor" (the string as a
+// factor with one level per zone present).  Each distinct code is made once
+// and shared by all the points in its zone.
+inline SEXP utmups_crs_column(const std::vector<int>& key, const std::string& type) {
+  size_t nn = key.size();
+  if (type == "epsg") {
+    std::vector<int> code(nkeys + 1, NA_INTEGER);
+    for (int kk = 0; kk < nkeys; kk++)
+      code[kk] = GeographicLib::UTMUPS::EncodeEPSG(kk / 2, kk % 2 == 1);
+    cpp11::writable::integers out(nn);
+    for (size_t i = 0; i < nn; i++) out[i] = code[key[i]];
+    return out;
+  }
+  if (type == "factor") {
+    // Levels in order of EPSG code: north before south, UPS after UTM
+    std::vector<int> level(nkeys + 1, NA_INTEGER);
+    for (size_t i = 0; i < nn; i++) level[key[i]] = 0;
+    cpp11::writable::strings levels;
+    for (int np = 1; np >= 0; np--) {
+      for (int z = 1; z <= GeographicLib::UTMUPS::MAXZONE + 1; z++) {
+        int kk = 2 * (z % (GeographicLib::UTMUPS::MAXZONE + 1)) + np;   // UPS last
+        if (level[kk] == 0) {
+          levels.push_back(utmups_crs(kk / 2, np == 1));
+          level[kk] = static_cast<int>(levels.size());
+        }
+      }
+    }
+    cpp11::writable::integers out(nn);
+    for (size_t i = 0; i < nn; i++) out[i] = level[key[i]];
+    out.attr("levels") = levels;
+    out.attr("class") = "factor";
+    return out;
+  }
+  if (type != "string") cpp11::stop("unknown crs type '%s'", type.c_str());
+  std::vector<cpp11::r_string> str(nkeys + 1, NA_STRING);
+  for (int kk = 0; kk < nkeys; kk++) str[kk] = utmups_crs(kk / 2, kk % 2 == 1);
+  cpp11::writable::strings out(nn);
+  for (size_t i = 0; i < nn; i++) out[i] = str[key[i]];
+  return out;
+}
+
+inline bool utmups_wants(const cpp11::strings& columns, const char* name) {
+  for (R_xlen_t i = 0; i < columns.size(); i++)
+    if (std::string(columns[i]) == name) return true;
+  return false;
+}
+
+} // namespace geographiclib_r
+
+#endif // GEOGRAPHICLIB_R_UTMUPS_H
@@ -27,6 +27,22 @@ namespace GeographicLib {
     rk = !(sig <= eps_) ? m / s : 1;
   }
 
+  void AzimuthalEquidistant::Forward(real lat0, real lon0,
+                                     const real lat[], const real lon[],
+                                     size_t n, real x[], real y[],
+                                     real azi[], real rk[]) const {
+    const Geodesic::InverseOrigin org = _earth.InverseFrom(lat0, lon0);
+    for (size_t i = 0; i < n; ++i) {
+      real sig, s, azi0, m, t;
+      sig = org.GenInverse(lat[i], lon[i], Geodesic::DISTANCE |
+                           Geodesic::AZIMUTH | Geodesic::REDUCEDLENGTH,
+                           s, azi0, azi[i], m, t, t, t);
+      Math::sincosd(azi0, x[i], y[i]);
+      x[i] *= s; y[i] *= s;
+      rk[i] = !(sig <= eps_) ? m / s : 1;
+    }
+  }
+
   void AzimuthalEquidistant::Reverse(real lat0, real lon0, real x, real y,
                                      real& lat, real& lon,
                                      real& azi, real& rk) const {
@@ -38,6 +38,10 @@ namespace GeographicLib {
   }
 
   Math::real DMS::Decode(const std::string& dms, flag& ind) {
+    return Decode(dms.data(), dms.size(), ind);
+  }
+
+  Math::real DMS::Decode(const char* dms, size_t len, flag& ind) {
     // Here's a table of the allowed characters
 
     // S unicode   dec  UTF-8      descripton
@@ -100,7 +104,12 @@ namespace GeographicLib {
     // « U+00ab    171  c2 ab      left guillemot (for cgi-bin)
     // » U+00bb    187  c2 bb      right guillemot (for cgi-bin)
 
-    string dmsa = dms;
+    {
+      real v;
+      if (FastDecode(dms, len, v, ind))
+        return v;
+    }
+    string dmsa(dms, len);
     replace(dmsa, "\xc2\xb0",     'd' ); // U+00b0 degree symbol
     replace(dmsa, "\xc2\xba",     'd' ); // U+00ba alt symbol
     replace(dmsa, "\xe2\x81\xb0", 'd' ); // U+2070 sup zero
@@ -194,6 +203,158 @@ namespace GeographicLib {
     return v;
   }
 
+  int DMS::FastIndicator(const char* s, size_t& p, size_t end) {
+    // The component indicator (0 = degrees, 1 = minutes, 2 = seconds, 3 =
+    // colon) starting at s[p], advancing p past it, or -1 (p unchanged) if
+    // s[p] does not start one of the symbols handled by FastDecode.
+    switch (s[p]) {
+    case 'd': case 'D': case '*': ++p; return 0;
+    case '\'': case '`': ++p; return 1;
+    case '"': ++p; return 2;
+    case ':': ++p; return 3;
+    case '\xc2':                // U+00b0 degree symbol, U+00ba alt symbol
+      if (p + 1 < end && (s[p+1] == '\xb0' || s[p+1] == '\xba'))
+        { p += 2; return 0; }
+      break;
+    case '\xe2':                // U+2019, U+2032 and U+201d, U+2033
+      if (p + 2 < end && s[p+1] == '\x80') {
+        if (s[p+2] == '\x99' || s[p+2] == '\xb2')
+          { p += 3; return 1; }
+        if (s[p+2] == '\x9d' || s[p+2] == '\xb3')
+          { p += 3; return 2; }
+      }
+      break;
+    default:
+      break;
+    }
+    return -1;
+  }
+
+  bool DMS::FastDecode(const char* s, size_t len, real& ang, flag& ind) {
+    // A transcription of Decode and InternalDecode for a single component
+    // string, reading the indicator symbols in place instead of substituting
+    // them first.  Every error of the general path gives false here, so that
+    // the general path can report it.  Decimal fractions are converted as
+    // m/10^n with m < 2^53 and n <= 22, which is exact before the one
+    // correctly rounded division and so matches the istringstream read.
+    static const real pow10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    const int maxcomponents = 3, maxpow = 22;
+    const unsigned long long maxmant = 1ULL << 53;
+    size_t beg = 0, end = len;
+    while (beg < end && (s[beg] == ' ' || (s[beg] >= '\t' && s[beg] <= '\r')))
+      ++beg;
+    while (beg < end && (s[end-1] == ' ' ||
+                         (s[end-1] >= '\t' && s[end-1] <= '\r')))
+      --end;
+    int sign = 1, k = -1;
+    flag ind1 = NONE;
+    if (end > beg && s[beg] != '\0' &&
+        (k = Utility::lookup(hemispheres_, s[beg])) >= 0) {
+      ind1 = (k / 2) ? LONGITUDE : LATITUDE;
+      sign = k % 2 ? 1 : -1;
+      ++beg;
+    }
+    if (end > beg && s[end-1] != '\0' &&
+        (k = Utility::lookup(hemispheres_, s[end-1])) >= 0) {
+      if (ind1 != NONE)
+        return false;
+      ind1 = (k / 2) ? LONGITUDE : LATITUDE;
+      sign = k % 2 ? 1 : -1;
+      --end;
+    }
+    if (end > beg && (s[beg] == '-' || s[beg] == '+')) {
+      sign *= s[beg] == '-' ? -1 : 1;
+      ++beg;
+    }
+    if (end == beg)
+      return false;
+    real ipieces[maxcomponents] = {0, 0, 0};
+    real fpieces[maxcomponents] = {0, 0, 0};
+    unsigned npiece = 0;
+    unsigned long long mant = 0; // All the digits of the current component
+    unsigned ncurrent = 0, digcount = 0;
+    bool pointseen = false, lastind = false;
+    size_t p = beg;
+    while (p < end) {
+      char x = s[p];
+      lastind = false;
+      if (x >= '0' && x <= '9') {
+        ++p;
+        ++ncurrent;
+        if (digcount > 0)
+          ++digcount;
+        mant = 10 * mant + unsigned(x - '0');
+        if (mant >= maxmant)
+          return false;
+      } else if (x == '.') {
+        ++p;
+        if (pointseen)
+          return false;
+        pointseen = true;
+        digcount = 1;
+      } else if ((k = FastIndicator(s, p, end)) >= 0) {
+        lastind = true;
+        if (k == 1 && p < end) {
+          // Two minutes symbols make a seconds symbol
+          size_t q = p;
+          if (FastIndicator(s, q, end) == 1) {
+            k = 2; p = q;
+          }
+        }
+        if (k >= maxcomponents) {
+          if (p == end)
+            return false;
+          k = npiece;
+        }
+        if (unsigned(k) + 1 == npiece || unsigned(k) < npiece ||
+            ncurrent == 0)
+          return false;
+        if (digcount > 0) {
+          if (int(digcount) - 1 > maxpow)
+            return false;
+          ipieces[k] = 0;
+          fpieces[k] = real(mant) / pow10[digcount - 1];
+        } else
+          ipieces[k] = fpieces[k] = real(mant);
+        if (p < end) {
+          npiece = k + 1;
+          if (npiece >= maxcomponents)
+            return false;
+          mant = 0;
+          ncurrent = digcount = 0;
+        }
+      } else
+        return false;
+    }
+    if (!lastind) {
+      if (npiece >= maxcomponents || ncurrent == 0)
+        return false;
+      if (digcount > 0) {
+        if (int(digcount) - 1 > maxpow)
+          return false;
+        ipieces[npiece] = 0;
+        fpieces[npiece] = real(mant) / pow10[digcount - 1];
+      } else
+        ipieces[npiece] = fpieces[npiece] = real(mant);
+    }
+    if ((pointseen && digcount == 0) ||
+        ipieces[1] >= Math::dm || fpieces[1] > Math::dm ||
+        ipieces[2] >= Math::ms || fpieces[2] > Math::ms)
+      return false;
+    real v = -0.0;              // So "-0" returns -0.0, as in Decode
+    v += real(sign) *
+      ( fpieces[2] != 0 ?
+        (Math::ms*(Math::dm*fpieces[0] + fpieces[1]) + fpieces[2])/Math::ds :
+        ( fpieces[1] != 0 ?
+          (Math::dm*fpieces[0] + fpieces[1]) / Math::dm : fpieces[0] ) );
+    ang = v;
+    ind = ind1;
+    return true;
+  }
+
   Math::real DMS::InternalDecode(const string& dmsa, flag& ind) {
     const int maxcomponents = 3;
     string errormsg;
@@ -374,10 +535,18 @@ namespace GeographicLib {
   void DMS::DecodeLatLon(const string& stra, const string& strb,
                          real& lat, real& lon,
                          bool longfirst) {
+    DecodeLatLon(stra.data(), stra.size(), strb.data(), strb.size(),
+                 lat, lon, longfirst);
+  }
+
+  void DMS::DecodeLatLon(const char* dmsa, size_t lena,
+                         const char* dmsb, size_t lenb,
+                         real& lat, real& lon,
+                         bool longfirst) {
     real a, b;
     flag ia, ib;
-    a = Decode(stra, ia);
-    b = Decode(strb, ib);
+    a = Decode(dmsa, lena, ia);
+    b = Decode(dmsb, lenb, ib);
     if (ia == NONE && ib == NONE) {
       // Default to lat, long unless longfirst
       ia = longfirst ? LONGITUDE : LATITUDE;
@@ -387,8 +556,8 @@ namespace GeographicLib {
     else if (ib == NONE)
       ib = flag(LATITUDE + LONGITUDE - ia);
     if (ia == ib)
-      throw GeographicErr("Both " + stra + " and "
-                          + strb + " interpreted as "
+      throw GeographicErr("Both " + string(dmsa, lena) + " and "
+                          + string(dmsb, lenb) + " interpreted as "
                           + (ia == LATITUDE ? "latitudes" : "longitudes"));
     real
       lat1 = ia == LATITUDE ? a : b,
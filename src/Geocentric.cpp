@@ -152,6 +152,102 @@ namespace GeographicLib {
       Rotation(sphi, cphi, slam, clam, M);
   }
 
+  void Geocentric::Forward(const real lat[], const real lon[], const real h[],
+                           size_t n, real X[], real Y[], real Z[]) const {
+    // IntForward on nbatch_ points at a time, with the same operations in
+    // the same order
+    if (!Init())
+      return;
+    const int nb = nbatch_;
+    for (size_t i = 0; i < n; i += nb) {
+      int m = int(min(size_t(nb), n - i));
+      real sphi[nbatch_], cphi[nbatch_], slam[nbatch_], clam[nbatch_];
+      for (int l = 0; l < m; ++l) {
+        Math::sincosd(Math::LatFix(lat[i + l]), sphi[l], cphi[l]);
+        Math::sincosd(lon[i + l], slam[l], clam[l]);
+      }
+      for (int l = 0; l < m; ++l) {
+        real nr = _a/sqrt(1 - _e2 * Math::sq(sphi[l])), r;
+        Z[i + l] = (_e2m * nr + h[i + l]) * sphi[l];
+        r = (nr + h[i + l]) * cphi[l];
+        Y[i + l] = r * slam[l];
+        X[i + l] = r * clam[l];
+      }
+    }
+  }
+
+  void Geocentric::Reverse(const real X[], const real Y[], const real Z[],
+                           size_t n, real lat[], real lon[], real h[]) const {
+    // The general branch of IntReverse (oblate, h <= _maxrad, not e4 * q ==
+    // 0 && r <= 0) on nbatch_ points at a time; a lane taking any other
+    // branch is redone by IntReverse.
+    if (!Init())
+      return;
+    const int nb = nbatch_;
+    size_t i = 0;
+    if (_e4a != 0 && _f >= 0) {
+      for (; i + nb <= n; i += nb) {
+        real R[nbatch_], slam[nbatch_], clam[nbatch_], hh[nbatch_],
+          q[nbatch_], r[nbatch_], S[nbatch_], r2[nbatch_], r3[nbatch_],
+          disc[nbatch_], u[nbatch_], sphi[nbatch_], cphi[nbatch_];
+        bool general[nbatch_];
+        for (int l = 0; l < nb; ++l) {
+          R[l] = hypot(X[i + l], Y[i + l]);
+          slam[l] = R[l] != 0 ? Y[i + l] / R[l] : 0;
+          clam[l] = R[l] != 0 ? X[i + l] / R[l] : 1;
+          hh[l] = hypot(R[l], Z[i + l]);
+        }
+        for (int l = 0; l < nb; ++l) {
+          real p = Math::sq(R[l] / _a);
+          q[l] = _e2m * Math::sq(Z[i + l] / _a);
+          r[l] = (p + q[l] - _e4a) / 6;
+          // Also false for NaN
+          general[l] = hh[l] <= _maxrad && !(_e4a * q[l] == 0 && r[l] <= 0);
+          S[l] = _e4a * p * q[l] / 4;
+          r2[l] = Math::sq(r[l]);
+          r3[l] = r[l] * r2[l];
+          disc[l] = S[l] * (2 * r3[l] + S[l]);
+        }
+        for (int l = 0; l < nb; ++l) {
+          u[l] = r[l];
+          if (disc[l] >= 0) {
+            real T3 = S[l] + r3[l];
+            T3 += T3 < 0 ? -sqrt(disc[l]) : sqrt(disc[l]);
+            real T = cbrt(T3);
+            u[l] += T + (T != 0 ? r2[l] / T : 0);
+          } else {
+            real ang = atan2(sqrt(-disc[l]), -(S[l] + r3[l]));
+            u[l] += 2 * r[l] * cos(ang / 3);
+          }
+        }
+        for (int l = 0; l < nb; ++l) {
+          real
+            v = sqrt(Math::sq(u[l]) + _e4a * q[l]),
+            uv = u[l] < 0 ? _e4a * q[l] / (v - u[l]) : u[l] + v,
+            w = fmax(real(0), _e2a * (uv - q[l]) / (2 * v)),
+            k = uv / (sqrt(uv + Math::sq(w)) + w),
+            k2 = k + _e2,
+            d = k * R[l] / k2,
+            H = hypot(Z[i + l]/k, R[l]/k2);
+          sphi[l] = (Z[i + l]/k) / H;
+          cphi[l] = (R[l]/k2) / H;
+          hh[l] = (1 - _e2m/k) * hypot(d, Z[i + l]);
+        }
+        for (int l = 0; l < nb; ++l) {
+          if (general[l]) {
+            lat[i + l] = Math::atan2d(sphi[l], cphi[l]);
+            lon[i + l] = Math::atan2d(slam[l], clam[l]);
+            h[i + l] = hh[l];
+          } else
+            IntReverse(X[i + l], Y[i + l], Z[i + l],
+                       lat[i + l], lon[i + l], h[i + l], NULL);
+        }
+      }
+    }
+    for (; i < n; ++i)
+      IntReverse(X[i], Y[i], Z[i], lat[i], lon[i], h[i], NULL);
+  }
+
   void Geocentric::Rotation(real sphi, real cphi, real slam, real clam,
                             real M[dim2_]) {
     // This rotation matrix is given by the following quaternion operations
@@ -170,7 +170,7 @@ namespace GeographicLib {
                                   real& salp1, real& calp1,
                                   real& salp2, real& calp2,
                                   real& m12, real& M12, real& M21,
-                                  real& S12) const {
+                                  real& S12, const InverseOrigin* org) const {
     if (_exact)
       return _geodexact.GenInverse(lat1, lon1, lat2, lon2,
                                    outmask, s12,
@@ -217,14 +217,20 @@ namespace GeographicLib {
 
     real sbet1, cbet1, sbet2, cbet2, s12x, m12x = Math::NaN();
 
-    Math::sincosd(lat1, sbet1, cbet1); sbet1 *= _f1;
-    // Ensure cbet1 = +epsilon at poles; doing the fix on beta means that sig12
-    // will be <= 2*tiny for two points at the same pole.
-    Math::norm(sbet1, cbet1); cbet1 = fmax(tiny_, cbet1);
+    // Reuse the reduced latitude of a fixed point 1 (InverseOrigin), which
+    // after the swap above may be either point.
+    if (!(org && org->Reduced(lat1, sbet1, cbet1))) {
+      Math::sincosd(lat1, sbet1, cbet1); sbet1 *= _f1;
+      // Ensure cbet1 = +epsilon at poles; doing the fix on beta means that
+      // sig12 will be <= 2*tiny for two points at the same pole.
+      Math::norm(sbet1, cbet1); cbet1 = fmax(tiny_, cbet1);
+    }
 
-    Math::sincosd(lat2, sbet2, cbet2); sbet2 *= _f1;
-    // Ensure cbet2 = +epsilon at poles
-    Math::norm(sbet2, cbet2); cbet2 = fmax(tiny_, cbet2);
+    if (!(org && org->Reduced(lat2, sbet2, cbet2))) {
+      Math::sincosd(lat2, sbet2, cbet2); sbet2 *= _f1;
+      // Ensure cbet2 = +epsilon at poles
+      Math::norm(sbet2, cbet2); cbet2 = fmax(tiny_, cbet2);
+    }
 
     // If cbet1 < -sbet1, then cbet2 - cbet1 is a sensitive measure of the
     // |bet1| - |bet2|.  Alternatively (cbet1 >= -sbet1), abs(sbet2) + sbet1 is
@@ -520,6 +526,40 @@ namespace GeographicLib {
     return a12;
   }
 
+  Geodesic::InverseOrigin::InverseOrigin(const Geodesic& geod,
+                                         real lat1, real lon1)
+    : _geod(&geod)
+    , _lat1(lat1)
+    , _lon1(lon1) {
+    // GenInverse sees point 1 with its latitude reflected or not, so cache
+    // both signs.
+    _lat[0] = Math::AngRound(Math::LatFix(lat1));
+    _lat[1] = -_lat[0];
+    for (int k = 0; k < 2; ++k) {
+      Math::sincosd(_lat[k], _sbet[k], _cbet[k]); _sbet[k] *= geod._f1;
+      Math::norm(_sbet[k], _cbet[k]); _cbet[k] = fmax(geod.tiny_, _cbet[k]);
+    }
+  }
+
+  Math::real Geodesic::InverseOrigin::GenInverse(real lat2, real lon2,
+                                                 unsigned outmask,
+                                                 real& s12,
+                                                 real& azi1, real& azi2,
+                                                 real& m12,
+                                                 real& M12, real& M21,
+                                                 real& S12) const {
+    outmask &= OUT_MASK;
+    real salp1, calp1, salp2, calp2,
+      a12 = _geod->GenInverse(_lat1, _lon1, lat2, lon2,
+                              outmask, s12, salp1, calp1, salp2, calp2,
+                              m12, M12, M21, S12, this);
+    if (outmask & AZIMUTH) {
+      azi1 = Math::atan2d(salp1, calp1);
+      azi2 = Math::atan2d(salp2, calp2);
+    }
+    return a12;
+  }
+
   GeodesicLine Geodesic::InverseLine(real lat1, real lon1,
                                      real lat2, real lon2,
                                      unsigned caps) const {
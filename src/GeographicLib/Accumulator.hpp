@@ -115,6 +115,23 @@ namespace GeographicLib {
      * @return \e sum.
      **********************************************************************/
     T operator()() const { return _s; }
+    /**
+     * Report both words of the accumulator, e.g., for checkpointing.
+     *
+     * @param[out] s the leading word (equal to \e sum).
+     * @param[out] t the trailing word, the rounding error of \e s.
+     **********************************************************************/
+    void GetState(T& s, T& t) const { s = _s; t = _t; }
+    /**
+     * Restore the accumulator from the words given by GetState().
+     *
+     * @param[in] s the leading word.
+     * @param[in] t the trailing word.
+     *
+     * Additions after this call give the same results as they would have
+     * given to the accumulator that was saved.
+     **********************************************************************/
+    void SetState(T s, T t) { _s = s; _t = t; }
     /**
      * Return the result of adding a number to \e sum (but don't change \e
      * sum).
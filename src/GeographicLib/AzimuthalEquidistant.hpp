@@ -107,6 +107,26 @@ namespace GeographicLib {
       Forward(lat0, lon0, lat, lon, x, y, azi, rk);
     }
 
+    /**
+     * Forward projection of many points about a single center point.
+     *
+     * @param[in] lat0 latitude of center point of projection (degrees).
+     * @param[in] lon0 longitude of center point of projection (degrees).
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] n the number of points.
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] azi array of \e n azimuths of the geodesic (degrees).
+     * @param[out] rk array of \e n reciprocals of the azimuthal scale.
+     *
+     * This gives the same results as calling AzimuthalEquidistant::Forward
+     * for each point, but the center point is set up only once (see
+     * Geodesic::InverseFrom).
+     **********************************************************************/
+    void Forward(real lat0, real lon0, const real lat[], const real lon[],
+                 size_t n, real x[], real y[], real azi[], real rk[]) const;
+
     /**
      * AzimuthalEquidistant::Reverse without returning the azimuth and scale.
      **********************************************************************/
@@ -99,6 +99,11 @@ namespace GeographicLib {
     static const char* const components_[3];
     static Math::real NumMatch(const std::string& s);
     static Math::real InternalDecode(const std::string& dmsa, flag& ind);
+    // Single pass decoding of the common forms; false means use the
+    // general path
+    static int FastIndicator(const char* s, std::size_t& p, std::size_t end);
+    static bool FastDecode(const char* s, std::size_t len,
+                           real& ang, flag& ind);
     DMS() = delete;             // Disable constructor
 
   public:
@@ -235,6 +240,26 @@ namespace GeographicLib {
      **********************************************************************/
     static Math::real Decode(const std::string& dms, flag& ind);
 
+    /**
+     * Convert a string in DMS to an angle.
+     *
+     * @param[in] dms pointer to the characters of the input.
+     * @param[in] len the number of characters in \e dms.
+     * @param[out] ind a DMS::flag value signaling the presence of a
+     *   hemisphere indicator.
+     * @exception GeographicErr if \e dms is malformed.
+     * @return angle (degrees).
+     *
+     * This is the same as Decode(const std::string&, flag&), but \e dms need
+     * not be null terminated.  Strings made of ASCII digits, a decimal
+     * point, a leading sign, hemisphere designators, and the d, ', &quot;,
+     * :, &deg;, prime, and double prime indicators are decoded in a single
+     * pass without allocating memory; anything else goes through the full
+     * substitution of the symbols listed above.  The results are the same
+     * either way.
+     **********************************************************************/
+    static Math::real Decode(const char* dms, std::size_t len, flag& ind);
+
     /**
      * Convert DMS to an angle.
      *
@@ -277,6 +302,27 @@ namespace GeographicLib {
                              real& lat, real& lon,
                              bool longfirst = false);
 
+    /**
+     * Convert a pair of character arrays to latitude and longitude.
+     *
+     * @param[in] dmsa pointer to the characters of the first string.
+     * @param[in] lena the number of characters in \e dmsa.
+     * @param[in] dmsb pointer to the characters of the second string.
+     * @param[in] lenb the number of characters in \e dmsb.
+     * @param[out] lat latitude (degrees).
+     * @param[out] lon longitude (degrees).
+     * @param[in] longfirst if true assume longitude is given before latitude
+     *   in the absence of hemisphere designators (default false).
+     * @exception GeographicErr as for DecodeLatLon(const std::string&, const
+     *   std::string&, real&, real&, bool).
+     *
+     * The strings are decoded with Decode(const char*, std::size_t, flag&).
+     **********************************************************************/
+    static void DecodeLatLon(const char* dmsa, std::size_t lena,
+                             const char* dmsb, std::size_t lenb,
+                             real& lat, real& lon,
+                             bool longfirst = false);
+
     /**
      * Convert a string to an angle in degrees.
      *
@@ -98,6 +98,9 @@ namespace GeographicLib {
                     real M[dim2_]) const;
     void IntReverse(real X, real Y, real Z, real& lat, real& lon, real& h,
                     real M[dim2_]) const;
+    // Lanes per group in the array Forward and Reverse (4 doubles = one AVX2
+    // register)
+    static const int nbatch_ = 4;
 
   public:
 
@@ -234,6 +237,48 @@ namespace GeographicLib {
         IntReverse(X, Y, Z, lat, lon, h, NULL);
     }
 
+    /**
+     * Convert an array of points from geodetic to geocentric coordinates.
+     *
+     * @param[in] lat latitudes of the points (degrees).
+     * @param[in] lon longitudes of the points (degrees).
+     * @param[in] h heights of the points above the ellipsoid (meters).
+     * @param[in] n number of points.
+     * @param[out] X geocentric coordinates (meters).
+     * @param[out] Y geocentric coordinates (meters).
+     * @param[out] Z geocentric coordinates (meters).
+     *
+     * The points are processed in groups of 4: the sines and cosines of the
+     * latitude and longitude are found point by point (Math::sincosd reduces
+     * the angles exactly), and the prime vertical radius and the coordinates
+     * across the points of a group, in a loop that the compiler can
+     * vectorize.  The results are the same as Geocentric::Forward.
+     **********************************************************************/
+    void Forward(const real lat[], const real lon[], const real h[], size_t n,
+                 real X[], real Y[], real Z[]) const;
+
+    /**
+     * Convert an array of points from geocentric to geodetic coordinates.
+     *
+     * @param[in] X geocentric coordinates (meters).
+     * @param[in] Y geocentric coordinates (meters).
+     * @param[in] Z geocentric coordinates (meters).
+     * @param[in] n number of points.
+     * @param[out] lat latitudes of the points (degrees).
+     * @param[out] lon longitudes of the points (degrees).
+     * @param[out] h heights of the points above the ellipsoid (meters).
+     *
+     * The closed-form solution of Geocentric::Reverse for an oblate
+     * ellipsoid runs across groups of 4 points, one step at a time, so that
+     * the arithmetic between the square and cube roots can be vectorized.
+     * Points needing one of its special cases (near the center, very far
+     * away, or NaN), a prolate ellipsoid or a sphere, and the last \e n mod
+     * 4 points use the scalar Reverse.  The results are the same as
+     * Geocentric::Reverse.
+     **********************************************************************/
+    void Reverse(const real X[], const real Y[], const real Z[], size_t n,
+                 real lat[], real lon[], real h[]) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -173,6 +173,8 @@ namespace GeographicLib {
    **********************************************************************/
 
   class GEOGRAPHICLIB_EXPORT Geodesic {
+  public:
+    class InverseOrigin;
   private:
     typedef Math::real real;
     friend class GeodesicLine;
@@ -237,7 +239,8 @@ namespace GeographicLib {
     real GenInverse(real lat1, real lon1, real lat2, real lon2,
                     unsigned outmask, real& s12,
                     real& salp1, real& calp1, real& salp2, real& calp2,
-                    real& m12, real& M12, real& M21, real& S12) const;
+                    real& m12, real& M12, real& M21, real& S12,
+                    const InverseOrigin* org = nullptr) const;
 
     // These are Maxima generated functions to provide series approximations to
     // the integrals for the ellipsoidal geodesic.
@@ -809,6 +812,99 @@ namespace GeographicLib {
                           real& m12, real& M12, real& M21, real& S12) const;
     ///@}
 
+    /** \name Inverse geodesic problem from a fixed point.
+     **********************************************************************/
+    ///@{
+    /**
+     * \brief Inverse problems sharing a common point 1.
+     *
+     * Returned by Geodesic::InverseFrom.  The reduced latitude of point 1
+     * (the sine and cosine of &beta;<sub>1</sub>, for both signs of the
+     * latitude, since the solution may swap and reflect the two points) is
+     * computed once when the object is constructed and reused for every
+     * point 2.  The results are identical to those of Geodesic::Inverse
+     * with the same point 1.  The object holds a pointer to the Geodesic
+     * which created it, so it must not outlive it.
+     **********************************************************************/
+    class GEOGRAPHICLIB_EXPORT InverseOrigin {
+    private:
+      friend class Geodesic;
+      const Geodesic* _geod;
+      real _lat1, _lon1;
+      real _lat[2], _sbet[2], _cbet[2];
+      InverseOrigin(const Geodesic& geod, real lat1, real lon1);
+      bool Reduced(real lat, real& sbet, real& cbet) const {
+        for (int k = 0; k < 2; ++k)
+          if (lat == _lat[k] && std::signbit(lat) == std::signbit(_lat[k])) {
+            sbet = _sbet[k]; cbet = _cbet[k];
+            return true;
+          }
+        return false;
+      }
+    public:
+      /**
+       * The general inverse geodesic calculation from point 1; see
+       * Geodesic::GenInverse.
+       **********************************************************************/
+      Math::real GenInverse(real lat2, real lon2, unsigned outmask,
+                            real& s12, real& azi1, real& azi2,
+                            real& m12, real& M12, real& M21, real& S12)
+        const;
+      /**
+       * The distance to point 2; see Geodesic::Inverse.
+       **********************************************************************/
+      Math::real Inverse(real lat2, real lon2, real& s12) const {
+        real t;
+        return GenInverse(lat2, lon2, DISTANCE, s12, t, t, t, t, t, t);
+      }
+      /**
+       * The distance and azimuths to point 2; see Geodesic::Inverse.
+       **********************************************************************/
+      Math::real Inverse(real lat2, real lon2,
+                         real& s12, real& azi1, real& azi2) const {
+        real t;
+        return GenInverse(lat2, lon2, DISTANCE | AZIMUTH,
+                          s12, azi1, azi2, t, t, t, t);
+      }
+      /**
+       * Distances (and optionally azimuths) to an array of \e n points 2;
+       * \e azi1 and \e azi2 may be nullptr.
+       **********************************************************************/
+      void Inverse(const real lat2[], const real lon2[], size_t n,
+                   real s12[], real azi1[] = nullptr,
+                   real azi2[] = nullptr) const {
+        unsigned outmask = DISTANCE | (azi1 || azi2 ? AZIMUTH : NONE);
+        for (size_t i = 0; i < n; ++i) {
+          real a1, a2, t;
+          GenInverse(lat2[i], lon2[i], outmask, s12[i], a1, a2, t, t, t, t);
+          if (azi1) azi1[i] = a1;
+          if (azi2) azi2[i] = a2;
+        }
+      }
+      /**
+       * @return latitude of point 1 (degrees).
+       **********************************************************************/
+      Math::real Latitude() const { return _lat1; }
+      /**
+       * @return longitude of point 1 (degrees).
+       **********************************************************************/
+      Math::real Longitude() const { return _lon1; }
+    };
+
+    /**
+     * Set up to solve many inverse problems with the same point 1.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @return a Geodesic::InverseOrigin object.
+     *
+     * \e lat1 should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    InverseOrigin InverseFrom(real lat1, real lon1) const {
+      return InverseOrigin(*this, lat1, lon1);
+    }
+    ///@}
+
     /** \name Interface to GeodesicLine.
      **********************************************************************/
     ///@{
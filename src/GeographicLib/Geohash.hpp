@@ -38,7 +38,11 @@ namespace GeographicLib {
     static const unsigned long long mask_ = 1ULL << 45;
     static const char* const lcdigits_;
     static const char* const ucdigits_;
+    // Bits per coordinate kept by the integer codes (12 characters)
+    static const int intbits_ = 30;
     Geohash() = delete;         // Disable constructor
+    static unsigned long long Spread(unsigned long long x);
+    static unsigned long long Compact(unsigned long long x);
 
   public:
 
@@ -82,6 +86,139 @@ namespace GeographicLib {
     static void Reverse(const std::string& geohash, real& lat, real& lon,
                         int& len, bool centerp = true);
 
+    /**
+     * The longest geohash with an integer code (60 bits).
+     **********************************************************************/
+    static const int maxintlen_ = 12;
+
+    /**
+     * The integer code returned by ForwardInt for a NaN position.
+     **********************************************************************/
+    static const unsigned long long invalidint_ = ~0ULL;
+
+    /**
+     * Convert an array of points from geographic coordinates to integer
+     * geohash codes.
+     *
+     * @param[in] lat latitudes of the points (degrees).
+     * @param[in] lon longitudes of the points (degrees).
+     * @param[in] n number of points.
+     * @param[in] len the length of the geohashes, in [1, 12].
+     * @param[out] code the geohashes as integers.
+     * @exception GeographicErr if \e len is not in [1, 12] or a \e lat is
+     *   not in [&minus;90&deg;, 90&deg;].
+     *
+     * The code of a geohash of length \e len is the number with its 5 \e
+     * len bits, i.e., the base-32 value of its characters, so codes of the
+     * same length sort as the strings do and a code divided by 32<sup>\e
+     * k</sup> is the code of the geohash shortened by \e k characters.  The
+     * bits of longitude and latitude are interleaved with shifts and masks
+     * (or with the BMI2 pdep instruction when the compiler targets it)
+     * rather than one at a time.  A NaN position gives Geohash::invalidint_.
+     **********************************************************************/
+    static void ForwardInt(const real lat[], const real lon[], size_t n,
+                           int len, unsigned long long code[]);
+
+    /**
+     * Convert an array of integer geohash codes to geographic coordinates.
+     *
+     * @param[in] code the geohashes as integers (see ForwardInt).
+     * @param[in] n number of codes.
+     * @param[in] len the length of the geohashes, in [1, 12].
+     * @param[out] lat latitudes (degrees).
+     * @param[out] lon longitudes (degrees).
+     * @param[in] centerp if true (the default) return the center of the
+     *   geohash location, otherwise return the south-west corner.
+     * @exception GeographicErr if \e len is not in [1, 12].
+     *
+     * The results are those of Reverse for the corresponding strings.  A
+     * code with more than 5 \e len bits (including Geohash::invalidint_)
+     * gives NaNs.
+     **********************************************************************/
+    static void ReverseInt(const unsigned long long code[], size_t n, int len,
+                           real lat[], real lon[], bool centerp = true);
+
+    /**
+     * Convert an integer geohash code to a string.
+     *
+     * @param[in] code the geohash as an integer (see ForwardInt).
+     * @param[in] len the length of the geohash, in [1, 12].
+     * @param[out] geohash the geohash, lower case.
+     *
+     * A code with more than 5 \e len bits gives "invalid".
+     **********************************************************************/
+    static void IntToString(unsigned long long code, int len,
+                            std::string& geohash);
+
+    /**
+     * Convert a geohash string to an integer code.
+     *
+     * @param[in] geohash the geohash.
+     * @param[out] len the length of the geohash.
+     * @return the geohash as an integer (see ForwardInt).
+     * @exception GeographicErr if \e geohash contains illegal characters or
+     *   is longer than 12 characters.
+     *
+     * The case of the letters in \e geohash is ignored.  As for Reverse, an
+     * "invalid" (or "nan") geohash gives Geohash::invalidint_.
+     **********************************************************************/
+    static unsigned long long StringToInt(const std::string& geohash,
+                                          int& len);
+
+    /**
+     * Split an integer geohash code into its column and row.
+     *
+     * @param[in] code the geohash as an integer (see ForwardInt).
+     * @param[in] len the length of the geohash, in [1, 12].
+     * @param[out] ix the column of the cell, counted eastwards from
+     *   &minus;180&deg;, in [0, 2<sup>LongitudeBits(\e len)</sup>).
+     * @param[out] iy the row of the cell, counted northwards from
+     *   &minus;90&deg;, in [0, 2<sup>LatitudeBits(\e len)</sup>).
+     * @return false if \e code has more than 5 \e len bits, when \e ix and
+     *   \e iy are unchanged.
+     *
+     * Neighboring cells are found by stepping \e ix and \e iy and
+     * recombining them with CellToInt.
+     **********************************************************************/
+    static bool IntToCell(unsigned long long code, int len,
+                          unsigned long long& ix, unsigned long long& iy) {
+      if (len < 1 || len > maxintlen_ || code >> (5 * len)) return false;
+      const int s = 2 * intbits_ - 5 * len;
+      code <<= s;
+      ix = Compact(code >> 1) >> (intbits_ - LongitudeBits(len));
+      iy = Compact(code)      >> (intbits_ - LatitudeBits(len));
+      return true;
+    }
+
+    /**
+     * Combine a column and row into an integer geohash code.
+     *
+     * @param[in] ix the column of the cell (see IntToCell).
+     * @param[in] iy the row of the cell (see IntToCell).
+     * @param[in] len the length of the geohash, in [1, 12].
+     * @return the geohash as an integer (see ForwardInt).
+     *
+     * \e ix and \e iy must be in range; this is not checked.
+     **********************************************************************/
+    static unsigned long long CellToInt(unsigned long long ix,
+                                        unsigned long long iy, int len) {
+      const int s = 2 * intbits_ - 5 * len;
+      return ((Spread(ix << (intbits_ - LongitudeBits(len))) << 1) |
+              Spread(iy << (intbits_ - LatitudeBits(len)))) >> s;
+    }
+
+    /**
+     * @param[in] len the length of the geohash.
+     * @return the number of bits of longitude in a geohash of length \e len.
+     **********************************************************************/
+    static int LongitudeBits(int len) { return (5 * len + 1) / 2; }
+
+    /**
+     * @param[in] len the length of the geohash.
+     * @return the number of bits of latitude in a geohash of length \e len.
+     **********************************************************************/
+    static int LatitudeBits(int len) { return (5 * len) / 2; }
+
     /**
      * The latitude resolution of a geohash.
      *
@@ -48,6 +48,8 @@ namespace GeographicLib {
     void IntReverse(real x, real y, real z, real& lat, real& lon, real& h,
                     real M[dim2_]) const;
     void MatrixMultiply(real M[dim2_]) const;
+    // Points per block of the array Reverse
+    static const size_t nblock_ = 64;
   public:
 
     /**
@@ -199,6 +201,46 @@ namespace GeographicLib {
         IntReverse(x, y, z, lat, lon, h, NULL);
     }
 
+    /**
+     * Convert an array of points from geodetic to local cartesian
+     * coordinates.
+     *
+     * @param[in] lat latitudes of the points (degrees).
+     * @param[in] lon longitudes of the points (degrees).
+     * @param[in] h heights of the points above the ellipsoid (meters).
+     * @param[in] n number of points.
+     * @param[out] x local cartesian coordinates (meters).
+     * @param[out] y local cartesian coordinates (meters).
+     * @param[out] z local cartesian coordinates (meters).
+     *
+     * The geocentric coordinates come from the array Geocentric::Forward,
+     * written to \e x, \e y, \e z, and are then shifted to the origin and
+     * rotated in place, in a loop that the compiler can vectorize.  The
+     * results are the same as LocalCartesian::Forward.
+     **********************************************************************/
+    void Forward(const real lat[], const real lon[], const real h[], size_t n,
+                 real x[], real y[], real z[]) const;
+
+    /**
+     * Convert an array of points from local cartesian to geodetic
+     * coordinates.
+     *
+     * @param[in] x local cartesian coordinates (meters).
+     * @param[in] y local cartesian coordinates (meters).
+     * @param[in] z local cartesian coordinates (meters).
+     * @param[in] n number of points.
+     * @param[out] lat latitudes of the points (degrees).
+     * @param[out] lon longitudes of the points (degrees).
+     * @param[out] h heights of the points above the ellipsoid (meters).
+     *
+     * The points are rotated and shifted to geocentric coordinates in blocks
+     * of 64 on the stack, and each block goes to the array
+     * Geocentric::Reverse.  The results are the same as
+     * LocalCartesian::Reverse.
+     **********************************************************************/
+    void Reverse(const real x[], const real y[], const real z[], size_t n,
+                 real lat[], real lon[], real h[]) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
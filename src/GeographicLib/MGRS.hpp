@@ -257,6 +257,32 @@ namespace GeographicLib {
     static void Forward(int zone, bool northp, real x, real y, real lat,
                         int prec, std::string& mgrs);
 
+    /**
+     * The longest MGRS string written by Forward (27 characters).
+     **********************************************************************/
+    static constexpr int maxmgrslen_ = 2 + 3 + 2 * maxprec_;
+
+    /**
+     * Convert UTM or UPS coordinate to an MGRS coordinate in a character
+     * buffer, when the latitude is known.
+     *
+     * @param[in] zone UTM zone (zero means UPS).
+     * @param[in] northp hemisphere (true means north, false means south).
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] lat latitude (degrees).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs the MGRS characters, not null terminated; the buffer
+     *   must hold MGRS::maxmgrslen_ characters.
+     * @return the number of characters written.
+     * @exception GeographicErr as for the std::string version.
+     *
+     * This is the std::string version without the string, for writing many
+     * MGRS references into one reusable buffer.
+     **********************************************************************/
+    static int Forward(int zone, bool northp, real x, real y, real lat,
+                       int prec, char mgrs[]);
+
     /**
      * Convert a MGRS coordinate to UTM or UPS coordinates.
      *
@@ -306,6 +332,33 @@ namespace GeographicLib {
                         int& zone, bool& northp, real& x, real& y,
                         int& prec, bool centerp = true);
 
+    /**
+     * Convert a MGRS coordinate held in a character buffer to UTM or UPS
+     * coordinates, and locate its components.
+     *
+     * @param[in] mgrs the MGRS characters (need not be null terminated).
+     * @param[in] len the number of characters.
+     * @param[out] zone UTM zone (zero means UPS).
+     * @param[out] northp hemisphere (true means north, false means south).
+     * @param[out] x easting of point (meters).
+     * @param[out] y northing of point (meters).
+     * @param[out] prec precision relative to 100 km.
+     * @param[out] gzdlen the length of the grid zone designation at the start
+     *   of \e mgrs (e.g., 3 for 38SMB4488); unless \e prec is &minus;1 or
+     *   &minus;2, the 2 letters of the 100 km block follow it and then \e
+     *   prec digits each of easting and northing.
+     * @param[in] centerp if true (default), return center of the MGRS square,
+     *   else return SW (lower left) corner.
+     * @exception GeographicErr if \e mgrs is illegal.
+     *
+     * The results are those of the std::string version, which calls this
+     * one, so a reference is parsed once for both its coordinates and the
+     * split that Decode gives.
+     **********************************************************************/
+    static void Reverse(const char* mgrs, int len,
+                        int& zone, bool& northp, real& x, real& y,
+                        int& prec, int& gzdlen, bool centerp = true);
+
     /**
      * Split a MGRS grid reference into its components.
      *
@@ -20,6 +20,8 @@
 #include <sstream>
 // Only for GeographicLib::GeographicErr
 #include <GeographicLib/Constants.hpp>
+// The worker pool of the R package, for building the tree on several threads
+#include "000_parallel_geographiclib.h"
 
 #if defined(GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION) && \
   GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION
@@ -78,9 +80,12 @@ namespace GeographicLib {
    * it's necessary to supply the same vector of points and the same distance
    * function.
    *
-   * There's no capability in this implementation to add or remove points from
-   * the set.  Instead Initialize() should be called to re-initialize the
-   * object with the modified vector of points.
+   * Points can be added to the set with Insert() and removed with Remove().
+   * Inserted points are placed in the spare slots of the leaf buckets and
+   * subtrees which become unbalanced are rebuilt; removed points are marked
+   * with tombstones and are dropped when the tree is compacted.
+   * UpdateStatistics() reports how far the tree has departed from a freshly
+   * built one, so that a full rebuild with Compact() can be scheduled.
    *
    * Because of the overhead in constructing a NearestNeighbor object for a
    * large set of points, functions Save() and Load() are provided to save the
@@ -95,7 +100,7 @@ namespace GeographicLib {
   template<typename dist_t, typename pos_t, class distfun_t>
   class NearestNeighbor {
     // For tracking changes to the I/O format
-    static const int version = 1;
+    static const int version = 2;
     // This is what we get "free"; but if sizeof(dist_t) = 1 (unlikely), allow
     // 4 slots (and this accommodates the default value bucket = 4).
     static const int maxbucket =
@@ -108,7 +113,10 @@ namespace GeographicLib {
      *
      * This is equivalent to specifying an empty set of points.
      **********************************************************************/
-    NearestNeighbor() : _numpoints(0), _bucket(0), _cost(0) {}
+    NearestNeighbor()
+      : _numpoints(0), _bucket(0), _cost(0)
+      , _ntree(0), _ntomb(0), _garbage(0), _inserted(0), _nremoved(0)
+      , _ucost(0) {}
 
     /**
      * Constructor for NearestNeighbor.
@@ -117,6 +125,8 @@ namespace GeographicLib {
      * @param[in] dist the distance function object.
      * @param[in] bucket the size of the buckets at the leaf nodes; this must
      *   lie in [0, 2 + 4*sizeof(dist_t)/sizeof(int)] (default 4).
+     * @param[in] nthreads the number of threads to use to build the tree
+     *   (default 1).
      * @exception GeographicErr if the value of \e bucket is out of bounds or
      *   the size of \e pts is too big for an int.
      * @exception std::bad_alloc if memory for the tree can't be allocated.
@@ -140,8 +150,8 @@ namespace GeographicLib {
      * to the Search() function.
      **********************************************************************/
     NearestNeighbor(const std::vector<pos_t>& pts, const distfun_t& dist,
-                    int bucket = 4) {
-      Initialize(pts, dist, bucket);
+                    int bucket = 4, int nthreads = 1) {
+      Initialize(pts, dist, bucket, nthreads);
     }
 
     /**
@@ -151,17 +161,26 @@ namespace GeographicLib {
      * @param[in] dist the distance function object.
      * @param[in] bucket the size of the buckets at the leaf nodes; this must
      *   lie in [0, 2 + 4*sizeof(dist_t)/sizeof(int)] (default 4).
+     * @param[in] nthreads the number of threads to use to build the tree
+     *   (default 1).
      * @exception GeographicErr if the value of \e bucket is out of bounds or
      *   the size of \e pts is too big for an int.
      * @exception std::bad_alloc if memory for the tree can't be allocated.
      *
      * See also the documentation on the constructor.
      *
+     * With \e nthreads > 1, the distances from a vantage point are computed
+     * in parallel for large nodes and the subtrees below them are built
+     * concurrently, on the worker pool of the R package (so a call from
+     * inside one of its tasks builds on one thread); \e dist must then be
+     * safe to call from several threads at once.  The resulting tree is
+     * identical to the one built with a single thread.
+     *
      * If an exception is thrown, the state of the NearestNeighbor is
      * unchanged.
      **********************************************************************/
     void Initialize(const std::vector<pos_t>& pts, const distfun_t& dist,
-                    int bucket = 4) {
+                    int bucket = 4, int nthreads = 1) {
       static_assert(std::numeric_limits<dist_t>::is_signed,
                     "dist_t must be a signed type");
       if (!( 0 <= bucket && bucket <= maxbucket ))
@@ -176,15 +195,126 @@ namespace GeographicLib {
       int cost = 0;
       std::vector<Node> tree;
       init(pts, dist, bucket, tree, ids, cost,
-           0, int(ids.size()), int(ids.size()/2));
+           0, int(ids.size()), int(ids.size()/2), nthreads);
       _tree.swap(tree);
       _numpoints = int(pts.size());
       _bucket = bucket;
+      _removed.clear();
+      _ntree = _numpoints; _ntomb = _garbage = 0;
+      _inserted = _nremoved = _ucost = 0;
       _mc = _sc = 0;
       _cost = cost; _c1 = _k = _cmax = 0;
       _cmin = std::numeric_limits<int>::max();
     }
 
+    /**
+     * Insert points into the NearestNeighbor.
+     *
+     * @param[in] pts the vector of points used for initialization with the
+     *   new points appended to it.
+     * @param[in] dist the distance function object used for initialization.
+     * @exception GeographicErr if \e pts is smaller than the number of points
+     *   in the set or is too big for an int.
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * The points <i>pts</i>[NumPoints()], <i>pts</i>[NumPoints() + 1], ...
+     * are added to the set with the corresponding indices.  Each new point
+     * descends the tree, widening the distance bounds of the nodes it passes
+     * through, and is stored in a spare slot of the bucket it reaches; a full
+     * bucket is split into a new subtree.  If the point ends up too deep in
+     * the tree, the smallest enclosing subtree which has become unbalanced
+     * (one child holding more than 3/4 of its points) is rebuilt.  This keeps
+     * the depth of the tree within a constant factor of that of a freshly
+     * built tree at an amortized cost of O(log<sup>2</sup> \e n) distance
+     * calculations per point.
+     *
+     * The same considerations as for Initialize() apply to the new points
+     * (no NaNs or infinities).  This is not thread safe.
+     **********************************************************************/
+    void Insert(const std::vector<pos_t>& pts, const distfun_t& dist) {
+      if (pts.size() > size_t(std::numeric_limits<int>::max()))
+        throw GeographicLib::GeographicErr("pts array too big");
+      if (int(pts.size()) < _numpoints)
+        throw GeographicLib::GeographicErr("pts array has wrong size");
+      if (!_removed.empty())
+        _removed.resize(pts.size(), 0);
+      // Count the points one at a time so that the object stays consistent
+      // if an exception is thrown.
+      while (_numpoints < int(pts.size())) {
+        insert(pts, dist, _numpoints);
+        ++_numpoints; ++_inserted;
+      }
+    }
+
+    /**
+     * Remove a point from the NearestNeighbor.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] index the index of the point to remove.
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object, if \e index is out of range, or if the
+     *   point has already been removed.
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * The point is marked with a tombstone: it is no longer returned by
+     * Search() but it stays in the tree (the distances to it are still needed
+     * to navigate the tree) and its index is not reused.  Once more than a
+     * quarter of the points in the tree are tombstones, the tree is compacted
+     * with Compact().  This is not thread safe.
+     **********************************************************************/
+    void Remove(const std::vector<pos_t>& pts, const distfun_t& dist,
+                int index) {
+      if (_numpoints != int(pts.size()))
+        throw GeographicLib::GeographicErr("pts array has wrong size");
+      if (!( 0 <= index && index < _numpoints ))
+        throw GeographicLib::GeographicErr("index out of range");
+      if (Removed(index))
+        throw GeographicLib::GeographicErr("point already removed");
+      if (_removed.empty())
+        _removed.resize(_numpoints, 0);
+      _removed[index] = 1;
+      ++_ntomb; ++_nremoved;
+      if (4 * _ntomb > _ntree)
+        Compact(pts, dist);
+    }
+
+    /**
+     * Rebuild the tree from the points which have not been removed.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] nthreads the number of threads to use to build the tree
+     *   (default 1).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * This drops the tombstones and restores the balance of the tree; the
+     * result is the same as calling Initialize() with just the remaining
+     * points, except that the points keep their indices.  The setup cost is
+     * replaced by the cost of the rebuild and the update statistics are
+     * reset.  If an exception is thrown, the state of the NearestNeighbor is
+     * unchanged.
+     **********************************************************************/
+    void Compact(const std::vector<pos_t>& pts, const distfun_t& dist,
+                 int nthreads = 1) {
+      if (_numpoints != int(pts.size()))
+        throw GeographicLib::GeographicErr("pts array has wrong size");
+      std::vector<item> ids;
+      ids.reserve(_ntree - _ntomb);
+      for (int k = 0; k < _numpoints; ++k)
+        if (!Removed(k)) ids.push_back(std::make_pair(dist_t(0), k));
+      int cost = 0;
+      std::vector<Node> tree;
+      init(pts, dist, _bucket, tree, ids, cost,
+           0, int(ids.size()), int(ids.size()/2), nthreads);
+      _tree.swap(tree);
+      _ntree = int(ids.size()); _ntomb = _garbage = 0;
+      _inserted = _nremoved = _ucost = 0;
+      _cost = cost;
+    }
+
     /**
      * Search the NearestNeighbor.
      *
@@ -205,7 +335,7 @@ namespace GeographicLib {
      *   to construct the object.
      *
      * The indices returned in \e ind are sorted by distance from \e query
-     * (closest first).
+     * (closest first).  Points removed with Remove() are never returned.
      *
      * The simplest invocation is with just the 4 non-optional arguments.  This
      * returns the closest distance and the index to the closest point in
@@ -256,9 +386,59 @@ namespace GeographicLib {
                   dist_t mindist = -1,
                   bool exhaustive = true,
                   dist_t tol = 0) const {
+      int c = -1;
+      dist_t d = SearchConst(pts, dist, query, ind, c,
+                             k, maxdist, mindist, exhaustive, tol);
+      RecordSearch(c);
+      return d;
+    }
+
+    /**
+     * Search the NearestNeighbor without updating the statistics.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] query the query point.
+     * @param[out] ind a vector of indices to the closest points found.
+     * @param[out] cost the number of distance calculations for this search
+     *   (&minus;1 if no search was needed).
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[out] dists if not null, set to the distances to the points
+     *   indexed by \e ind (default null).
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * The distances returned in \e dists are the values of
+     * <i>dist</i>(<i>pts</i>[<i>ind</i><sub><i>j</i></sub>], \e query)
+     * computed during the search, so they need not be found again.
+     *
+     * This is the same as Search() except that the statistics counters are
+     * left alone, so that, unlike Search(), it may be called from several
+     * threads at once (provided that \e dist is thread safe).  Pass \e cost
+     * to RecordSearch() afterwards to include the search in the statistics.
+     **********************************************************************/
+    dist_t SearchConst(const std::vector<pos_t>& pts, const distfun_t& dist,
+                       const pos_t& query,
+                       std::vector<int>& ind,
+                       int& cost,
+                       int k = 1,
+                       dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                       dist_t mindist = -1,
+                       bool exhaustive = true,
+                       dist_t tol = 0,
+                       std::vector<dist_t>* dists = nullptr) const {
       if (_numpoints != int(pts.size()))
           throw GeographicLib::GeographicErr("pts array has wrong size");
       std::priority_queue<item> results;
+      cost = -1;
       if (_numpoints > 0 && k > 0 && maxdist > mindist) {
         // distance to the kth closest point so far
         dist_t tau = maxdist;
@@ -284,7 +464,7 @@ namespace GeographicLib {
             dst = dist(pts[index], query);
             ++c;
 
-            if (dst > mindist && dst <= tau) {
+            if (dst > mindist && dst <= tau && !Removed(index)) {
               if (int(results.size()) == k) results.pop();
               results.push(std::make_pair(dst, index));
               if (int(results.size()) == k) {
@@ -321,20 +501,16 @@ namespace GeographicLib {
             }
           }
         }
-        ++_k;
-        _c1 += c;
-        double omc = _mc;
-        _mc += (c - omc) / _k;
-        _sc += (c - omc) * (c - _mc);
-        if (c > _cmax) _cmax = c;
-        if (c < _cmin) _cmin = c;
+        cost = c;
       }
 
       dist_t d = -1;
       ind.resize(results.size());
+      if (dists) dists->resize(results.size());
 
       for (int i = int(ind.size()); i--;) {
         ind[i] = int(results.top().second);
+        if (dists) (*dists)[i] = results.top().first;
         if (i == 0) d = results.top().first;
         results.pop();
       }
@@ -342,11 +518,38 @@ namespace GeographicLib {
 
     }
 
+    /**
+     * Include a search in the statistics.
+     *
+     * @param[in] cost the cost of the search, as returned by SearchConst();
+     *   negative values (no search needed) are ignored.
+     *
+     * This is not thread safe.
+     **********************************************************************/
+    void RecordSearch(int cost) const {
+      if (cost < 0) return;
+      int c = cost;
+      ++_k;
+      _c1 += c;
+      double omc = _mc;
+      _mc += (c - omc) / _k;
+      _sc += (c - omc) * (c - _mc);
+      if (c > _cmax) _cmax = c;
+      if (c < _cmin) _cmin = c;
+    }
+
     /**
      * @return the total number of points in the set.
      **********************************************************************/
     int NumPoints() const { return _numpoints; }
 
+    /**
+     * @param[in] index the index of a point, in [0, NumPoints()).
+     * @return whether the point has been removed with Remove().
+     **********************************************************************/
+    bool Removed(int index) const
+    { return !_removed.empty() && _removed[index]; }
+
     /**
      * Write the object to an I/O stream.
      *
@@ -355,8 +558,10 @@ namespace GeographicLib {
      * @exception std::bad_alloc if memory for the string representation of the
      *   object can't be allocated.
      *
-     * The counters tracking the statistics of searches are not saved; however
-     * the initializtion cost is saved.  The format of the binary saves is \e
+     * The counters tracking the statistics of searches and updates are not
+     * saved; however the initializtion cost is saved.  The tree is written
+     * without the nodes left behind by partial rebuilds, together with the
+     * indices of the removed points.  The format of the binary saves is \e
      * not portable.
      *
      * \note <a href="https://www.boost.org/libs/serialization/doc">
@@ -367,6 +572,10 @@ namespace GeographicLib {
     void Save(std::ostream& os, bool bin = true) const {
       int realspec = std::numeric_limits<dist_t>::digits *
         (std::numeric_limits<dist_t>::is_integer ? -1 : 1);
+      std::vector<Node> packed;
+      if (_garbage > 0) pack(int(_tree.size()) - 1, packed);
+      const std::vector<Node>& tree = _garbage > 0 ? packed : _tree;
+      std::vector<int> rem = removedlist();
       if (bin) {
         char id[] = "NearestNeighbor_";
         os.write(id, 16);
@@ -375,11 +584,11 @@ namespace GeographicLib {
         buf[1] = realspec;
         buf[2] = _bucket;
         buf[3] = _numpoints;
-        buf[4] = int(_tree.size());
+        buf[4] = int(tree.size());
         buf[5] = _cost;
         os.write(reinterpret_cast<const char *>(buf), 6 * sizeof(int));
-        for (int i = 0; i < int(_tree.size()); ++i) {
-          const Node& node = _tree[i];
+        for (int i = 0; i < int(tree.size()); ++i) {
+          const Node& node = tree[i];
           os.write(reinterpret_cast<const char *>(&node.index), sizeof(int));
           if (node.index >= 0) {
             os.write(reinterpret_cast<const char *>(node.data.lower),
@@ -393,6 +602,11 @@ namespace GeographicLib {
                      _bucket * sizeof(int));
           }
         }
+        int nrem = int(rem.size());
+        os.write(reinterpret_cast<const char *>(&nrem), sizeof(int));
+        if (nrem > 0)
+          os.write(reinterpret_cast<const char *>(rem.data()),
+                   nrem * sizeof(int));
       } else {
         std::stringstream ostring;
           // Ensure enough precision for type dist_t.  With C++11, max_digits10
@@ -404,9 +618,9 @@ namespace GeographicLib {
           ostring.precision(prec);
         }
         ostring << version << " " << realspec << " " << _bucket << " "
-                << _numpoints << " " << _tree.size() << " " << _cost;
-        for (int i = 0; i < int(_tree.size()); ++i) {
-          const Node& node = _tree[i];
+                << _numpoints << " " << tree.size() << " " << _cost;
+        for (int i = 0; i < int(tree.size()); ++i) {
+          const Node& node = tree[i];
           ostring << "\n" << node.index;
           if (node.index >= 0) {
             for (int l = 0; l < 2; ++l)
@@ -417,6 +631,9 @@ namespace GeographicLib {
               ostring << " " << node.leaves[l];
           }
         }
+        ostring << "\n" << rem.size();
+        for (int i : rem)
+          ostring << " " << i;
         os << ostring.str();
       }
     }
@@ -429,8 +646,9 @@ namespace GeographicLib {
      * @exception GeographicErr if the state read from \e is is illegal.
      * @exception std::bad_alloc if memory for the tree can't be allocated.
      *
-     * The counters tracking the statistics of searches are reset by this
-     * operation.  Binary data must have been saved on a machine with the same
+     * The counters tracking the statistics of searches and updates are reset
+     * by this operation.  Data saved in the format used before points could
+     * be removed (version 1) can still be read.  Binary data must have been saved on a machine with the same
      * architecture.  If an exception is thrown, the state of the
      * NearestNeighbor is unchanged.
      *
@@ -461,7 +679,7 @@ namespace GeographicLib {
                >> cost ))
           throw GeographicLib::GeographicErr("Bad header");
       }
-      if (!( version1 == version ))
+      if (!( version1 == 1 || version1 == version ))
         throw GeographicLib::GeographicErr("Incompatible version");
       if (!( realspec == std::numeric_limits<dist_t>::digits *
              (std::numeric_limits<dist_t>::is_integer ? -1 : 1) ))
@@ -515,9 +733,32 @@ namespace GeographicLib {
         node.Check(numpoints, treesize, bucket);
         tree.push_back(node);
       }
+      std::vector<char> removed;
+      if (version1 >= 2) {
+        int nrem;
+        if (bin)
+          is.read(reinterpret_cast<char *>(&nrem), sizeof(int));
+        else if (!( is >> nrem ))
+          throw GeographicLib::GeographicErr("Bad removed points");
+        if (!( 0 <= nrem && nrem <= numpoints ))
+          throw GeographicLib::GeographicErr("Bad removed points");
+        if (nrem > 0) removed.resize(numpoints, 0);
+        for (int j = 0; j < nrem; ++j) {
+          int i;
+          if (bin)
+            is.read(reinterpret_cast<char *>(&i), sizeof(int));
+          else if (!( is >> i ))
+            throw GeographicLib::GeographicErr("Bad removed points");
+          if (!( 0 <= i && i < numpoints && !removed[i] ))
+            throw GeographicLib::GeographicErr("Bad removed points");
+          removed[i] = 1;
+        }
+      }
       _tree.swap(tree);
       _numpoints = numpoints;
       _bucket = bucket;
+      _removed.swap(removed);
+      recount();
       _mc = _sc = 0;
       _cost = cost; _c1 = _k = _cmax = 0;
       _cmin = std::numeric_limits<int>::max();
@@ -555,6 +796,13 @@ namespace GeographicLib {
       std::swap(_bucket, t._bucket);
       std::swap(_cost, t._cost);
       _tree.swap(t._tree);
+      _removed.swap(t._removed);
+      std::swap(_ntree, t._ntree);
+      std::swap(_ntomb, t._ntomb);
+      std::swap(_garbage, t._garbage);
+      std::swap(_inserted, t._inserted);
+      std::swap(_nremoved, t._nremoved);
+      std::swap(_ucost, t._ucost);
       std::swap(_mc, t._mc);
       std::swap(_sc, t._sc);
       std::swap(_c1, t._c1);
@@ -576,6 +824,11 @@ namespace GeographicLib {
      *
      * Here "cost" measures the number of distance calculations needed.  Note
      * that the accumulation of statistics is \e not thread safe.
+     *
+     * After updates with Insert() and Remove(), a growing mean cost of
+     * searches relative to that for the freshly built tree (call
+     * ResetStatistics() after building it) measures how far the tree has
+     * degraded; UpdateStatistics() gives the structural measures.
      **********************************************************************/
     void Statistics(int& setupcost, int& numsearches, int& searchcost,
                     int& mincost, int& maxcost,
@@ -585,6 +838,48 @@ namespace GeographicLib {
       mean = _mc; sd = std::sqrt(_sc / (_k - 1));
     }
 
+    /**
+     * Statistics on the updates since the tree was last built.
+     *
+     * @param[out] inserted the number of points added by Insert().
+     * @param[out] removed the number of points removed by Remove().
+     * @param[out] tombstones the number of removed points still in the tree.
+     * @param[out] updatecost the cost of the calls to Insert() including the
+     *   partial rebuilds.
+     * @param[out] depth the number of levels in the tree.
+     * @param[out] balanceddepth the number of levels in a tree built afresh
+     *   from the points which have not been removed.
+     *
+     * The counters are reset by Initialize(), Compact(), and Load().  Each
+     * tombstone adds a wasted distance calculation to the searches which
+     * reach it, and each extra level of \e depth over \e balanceddepth
+     * lengthens the searches through that part of the tree.  Comparing \e
+     * updatecost with the setup cost returned by Statistics() tells whether
+     * a Compact() is due.  Computing \e depth requires a traversal of the
+     * tree.
+     **********************************************************************/
+    void UpdateStatistics(int& inserted, int& removed, int& tombstones,
+                          int& updatecost,
+                          int& depth, int& balanceddepth) const {
+      inserted = _inserted; removed = _nremoved; tombstones = _ntomb;
+      updatecost = _ucost;
+      depth = 0;
+      std::vector<std::pair<int, int>> todo;
+      if (!_tree.empty())
+        todo.push_back(std::make_pair(int(_tree.size()) - 1, 1));
+      while (!todo.empty()) {
+        int n = todo.back().first, d = todo.back().second;
+        todo.pop_back();
+        if (d > depth) depth = d;
+        const Node& node = _tree[n];
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0)
+              todo.push_back(std::make_pair(node.data.child[l], d + 1));
+      }
+      balanceddepth = levels(_ntree - _ntomb, _bucket);
+    }
+
     /**
      * Reset the counters for the accumulated statistics on the searches so
      * far.
@@ -689,17 +984,21 @@ namespace GeographicLib {
       // Need to use version1, otherwise load error in debug mode on Linux:
       // undefined reference to GeographicLib::NearestNeighbor<...>::version.
       int version1 = version;
+      std::vector<Node> tree;
+      if (_garbage > 0) pack(int(_tree.size()) - 1, tree);
+      std::vector<int> rem = removedlist();
       ar & boost::serialization::make_nvp("version", version1)
         & boost::serialization::make_nvp("realspec", realspec)
         & boost::serialization::make_nvp("bucket", _bucket)
         & boost::serialization::make_nvp("numpoints", _numpoints)
         & boost::serialization::make_nvp("cost", _cost)
-        & boost::serialization::make_nvp("tree", _tree);
+        & boost::serialization::make_nvp("tree", _garbage > 0 ? tree : _tree)
+        & boost::serialization::make_nvp("removed", rem);
     }
     template<class Archive> void load(Archive& ar, const unsigned) {
       int version1, realspec, bucket, numpoints, cost;
       ar & boost::serialization::make_nvp("version", version1);
-      if (version1 != version)
+      if (!( version1 == 1 || version1 == version ))
         throw GeographicLib::GeographicErr("Incompatible version");
       std::vector<Node> tree;
       ar & boost::serialization::make_nvp("realspec", realspec);
@@ -717,9 +1016,22 @@ namespace GeographicLib {
           GeographicLib::GeographicErr("Bad number of points or tree size");
       for (int i = 0; i < int(tree.size()); ++i)
         tree[i].Check(numpoints, int(tree.size()), bucket);
+      std::vector<char> removed;
+      if (version1 >= 2) {
+        std::vector<int> rem;
+        ar & boost::serialization::make_nvp("removed", rem);
+        if (!rem.empty()) removed.resize(numpoints, 0);
+        for (int i : rem) {
+          if (!( 0 <= i && i < numpoints && !removed[i] ))
+            throw GeographicLib::GeographicErr("Bad removed points");
+          removed[i] = 1;
+        }
+      }
       _tree.swap(tree);
       _numpoints = numpoints;
       _bucket = bucket;
+      _removed.swap(removed);
+      recount();
       _mc = _sc = 0;
       _cost = cost; _c1 = _k = _cmax = 0;
       _cmin = std::numeric_limits<int>::max();
@@ -731,53 +1043,310 @@ namespace GeographicLib {
 
     int _numpoints, _bucket, _cost;
     std::vector<Node> _tree;
+    // Tombstones indexed by point (empty if no points have been removed)
+    std::vector<char> _removed;
+    // Points in the tree (including tombstones), tombstones in the tree,
+    // and unreachable nodes in _tree left behind by partial rebuilds
+    int _ntree, _ntomb, _garbage;
+    // Counters to track statistics on the updates
+    int _inserted, _nremoved, _ucost;
     // Counters to track stastistics on the cost of searches
     mutable double _mc, _sc;
     mutable int _c1, _k, _cmin, _cmax;
 
+    std::vector<int> removedlist() const {
+      std::vector<int> rem;
+      for (int i = 0; i < int(_removed.size()); ++i)
+        if (_removed[i]) rem.push_back(i);
+      return rem;
+    }
+
+    // Number of levels in a tree built by init from n points
+    static int levels(int n, int bucket) {
+      int h = 0;
+      for (; n > (bucket == 0 ? 1 : bucket); n /= 2) ++h;
+      return h + (n > 0 ? 1 : 0);
+    }
+
+    // Set _ntree and _ntomb for a freshly loaded tree (which has no garbage)
+    void recount() {
+      _ntree = _ntomb = 0;
+      for (const Node& node : _tree)
+        for (int i = 0; i < (node.index < 0 ? _bucket : 1); ++i) {
+          int index = node.index < 0 ? node.leaves[i] : node.index;
+          if (index < 0) break;
+          ++_ntree;
+          if (Removed(index)) ++_ntomb;
+        }
+      _garbage = 0;
+      _inserted = _nremoved = _ucost = 0;
+    }
+
+    // Call f(index) for each point in the subtree rooted at n and return the
+    // number of nodes in the subtree
+    template<class F> int visit(int n, F f) const {
+      int nodes = 0;
+      std::vector<int> todo;
+      if (n >= 0) todo.push_back(n);
+      while (!todo.empty()) {
+        const Node& node = _tree[todo.back()];
+        todo.pop_back();
+        ++nodes;
+        if (node.index >= 0) {
+          f(node.index);
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0) todo.push_back(node.data.child[l]);
+        } else {
+          for (int i = 0; i < _bucket && node.leaves[i] >= 0; ++i)
+            f(node.leaves[i]);
+        }
+      }
+      return nodes;
+    }
+
+    int count(int n) const {
+      int c = 0;
+      visit(n, [&c](int) { ++c; });
+      return c;
+    }
+
+    // Copy the subtree rooted at n to tree in post-order, leaving out
+    // unreachable nodes, and return the index of its root
+    int pack(int n, std::vector<Node>& tree) const {
+      if (n < 0) return -1;
+      Node node = _tree[n];
+      if (node.index >= 0)
+        for (int l = 0; l < 2; ++l)
+          node.data.child[l] = pack(node.data.child[l], tree);
+      tree.push_back(node);
+      return int(tree.size()) - 1;
+    }
+
+    // A node holding just point id
+    Node single(int id) const {
+      Node node;
+      if (_bucket == 0)
+        node.index = id;
+      else {
+        node.leaves[0] = id;
+        for (int i = 1; i < _bucket; ++i)
+          node.leaves[i] = -1;
+        for (int i = _bucket; i < maxbucket; ++i)
+          node.leaves[i] = 0;
+      }
+      return node;
+    }
+
+    // Nodes added to _tree go in front of the root so that the root stays
+    // last (Search, Save, and Load rely on this).  The root is not the child
+    // of any node, so moving it only changes its own index.
+    int add(const Node& node) {
+      Node root = _tree.back();
+      _tree.back() = node;
+      _tree.push_back(root);
+      return int(_tree.size()) - 2;
+    }
+
+    // Replace the subtree rooted at n, whose parent is p, and which contains
+    // nodes nodes, by sub (in post-order with local child pointers).  The
+    // root of sub takes over slot n, so the child pointer of p is unchanged
+    // unless sub is empty.
+    void splice(int n, int p, const std::vector<Node>& sub, int nodes) {
+      if (n == int(_tree.size()) - 1) {
+        _tree = sub;
+        _garbage = 0;
+        return;
+      }
+      if (sub.empty()) {
+        typename Node::bounds& data = _tree[p].data;
+        if (data.child[0] == n) {
+          data.child[0] = -1;
+          data.lower[0] = data.upper[0] = 0;
+        } else {
+          data.child[1] = -1;
+          data.lower[1] = data.upper[1] = data.upper[0];
+        }
+        _garbage += nodes;
+        return;
+      }
+      Node root = _tree.back();
+      _tree.pop_back();
+      int s = int(sub.size()), offset = int(_tree.size());
+      for (int j = 0; j < s; ++j) {
+        Node node = sub[j];
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l) {
+            int c = node.data.child[l];
+            node.data.child[l] = c < 0 ? -1 : (c == s - 1 ? n : offset + c);
+          }
+        if (j == s - 1)
+          _tree[n] = node;
+        else
+          _tree.push_back(node);
+      }
+      _tree.push_back(root);
+      _garbage += nodes - 1;
+    }
+
+    // Rebuild the subtree rooted at n, whose parent is p, from its points
+    // other than tombstones, adding point extra if it's non-negative.
+    void rebuild(const std::vector<pos_t>& pts, const distfun_t& dist,
+                 int n, int p, int extra, int& cost) {
+      std::vector<item> ids;
+      int dropped = 0;
+      int nodes = visit(n, [&](int i) {
+        if (Removed(i))
+          ++dropped;
+        else
+          ids.push_back(std::make_pair(dist_t(0), i));
+      });
+      if (extra >= 0) ids.push_back(std::make_pair(dist_t(0), extra));
+      std::vector<Node> sub;
+      init(pts, dist, _bucket, sub, ids, cost,
+           0, int(ids.size()), int(ids.size()/2));
+      splice(n, p, sub, nodes);
+      _ntree -= dropped; _ntomb -= dropped;
+    }
+
+    // Insert point id into the tree
+    void insert(const std::vector<pos_t>& pts, const distfun_t& dist,
+                int id) {
+      int cost = 0;
+      if (_tree.empty()) {
+        _tree.push_back(single(id));
+        ++_ntree;
+        return;
+      }
+      // Descend to a leaf or an empty child, widening the bounds on the way
+      std::vector<int> path;    // the interior nodes visited
+      int n = int(_tree.size()) - 1, l = 0;
+      for (;;) {
+        Node& node = _tree[n];
+        if (node.index < 0) break;
+        path.push_back(n);
+        dist_t d = dist(pts[node.index], pts[id]);
+        ++cost;
+        typename Node::bounds& data = node.data;
+        l = data.child[1] >= 0 ? (d < data.lower[1] ? 0 : 1) :
+          (data.child[0] >= 0 && d <= data.upper[0] ? 0 : 1);
+        if (data.child[l] < 0) {
+          data.lower[l] = data.upper[l] = d;
+          n = -1;
+          break;
+        }
+        if (l == 0) {
+          data.lower[0] = (std::min)(data.lower[0], d);
+          data.upper[0] = (std::max)(data.upper[0], d);
+        } else
+          data.upper[1] = (std::max)(data.upper[1], d);
+        n = data.child[l];
+      }
+      ++_ntree;
+      int root = int(_tree.size()) - 1;
+      if (n < 0) {
+        // New node for the empty child
+        n = add(single(id));
+        if (path.back() == root) path.back() = root + 1;
+        _tree[path.back()].data.child[l] = n;
+      } else {
+        Node& leaf = _tree[n];
+        int i = 0;
+        while (i < _bucket && leaf.leaves[i] >= 0) ++i;
+        if (i < _bucket)
+          leaf.leaves[i] = id;  // a spare slot in the bucket
+        else {
+          // Split the full bucket
+          rebuild(pts, dist, n, path.empty() ? -1 : path.back(), id, cost);
+          if (path.empty()) n = int(_tree.size()) - 1;
+        }
+      }
+      if (!path.empty()) path[0] = int(_tree.size()) - 1;
+
+      // If the new point is too deep in the tree, there's an ancestor with
+      // one child holding more than 3/4 of the ancestor's points; rebuild
+      // the lowest such ancestor.
+      if (int(path.size()) + 1 >
+          1 + int(std::log(double(_ntree)) / std::log(4/3.0))) {
+        int size = count(n);
+        for (int j = int(path.size()); j--;) {
+          const typename Node::bounds& data = _tree[path[j]].data;
+          int sib = data.child[0] == n ? data.child[1] : data.child[0],
+            psize = 1 + size + count(sib);
+          if (4 * size > 3 * psize) {
+            rebuild(pts, dist, path[j], j > 0 ? path[j-1] : -1, -1, cost);
+            break;
+          }
+          n = path[j]; size = psize;
+        }
+      }
+      _ucost += cost;
+
+      // Reclaim the nodes left behind by the partial rebuilds
+      if (_garbage > int(_tree.size()) / 2) {
+        std::vector<Node> tree;
+        pack(int(_tree.size()) - 1, tree);
+        _tree.swap(tree);
+        _garbage = 0;
+      }
+    }
+
+    // Nodes with fewer points than this are handled by a single thread.
+    static const int minparallel = 4096;
+
+    // A large node while the tree is built on several threads: the
+    // finished node (child pointers unset) and handles for its children,
+    // -1 for none, k >= 0 for splits[k], and -2 - k for jobs[k].
+    struct split {
+      Node node;
+      int child[2];
+    };
+    // A subtree of fewer than minparallel points, built by one thread
+    struct job {
+      int l, u, vp, root, cost;
+      std::vector<Node> tree;
+    };
+
+    // Append the subtree for ids[l, u) to tree in post-order (so its root is
+    // the last node added) and return the index of its root.  nthreads
+    // threads are available for the subtree.
+    //
+    // With several threads, the nodes with at least minparallel points are
+    // split first on the calling thread, with their vantage point distances
+    // computed on the worker pool.  This leaves independent subtrees over
+    // disjoint ranges of ids which are then built on the pool, each by one
+    // thread, into separate vectors.  Appending these in order, with the
+    // child pointers offset, gives the same tree as the sequential build.
     int init(const std::vector<pos_t>& pts, const distfun_t& dist, int bucket,
              std::vector<Node>& tree, std::vector<item>& ids, int& cost,
-             int l, int u, int vp) {
+             int l, int u, int vp, int nthreads = 1) {
+
+      if (nthreads > 1 && u - l >= minparallel) {
+        std::vector<split> splits;
+        std::vector<job> jobs;
+        int top = initsplit(pts, dist, bucket, ids, cost, l, u, vp, nthreads,
+                            splits, jobs);
+        geographiclib_r::parallel_tasks(jobs.size(), nthreads,
+                                        [&](size_t k) {
+          job& j = jobs[k];
+          j.root = init(pts, dist, bucket, j.tree, ids, j.cost,
+                        j.l, j.u, j.vp);
+        });
+        for (const job& j : jobs) cost += j.cost;
+        return assemble(tree, splits, jobs, top);
+      }
 
       if (u == l)
         return -1;
       Node node;
 
       if (u - l > (bucket == 0 ? 1 : bucket)) {
-
-        // choose a vantage point and move it to the start
-        int i = vp;
-        std::swap(ids[l], ids[i]);
-
-        int m = (u + l + 1) / 2;
-
-        for (int k = l + 1; k < u; ++k) {
-          ids[k].first = dist(pts[ids[l].second], pts[ids[k].second]);
-          ++cost;
-        }
-        // partition around the median distance
-        std::nth_element(ids.begin() + l + 1,
-                         ids.begin() + m,
-                         ids.begin() + u);
-        node.index = ids[l].second;
-        if (m > l + 1) {        // node.child[0] is possibly empty
-          typename std::vector<item>::iterator
-            t = std::min_element(ids.begin() + l + 1, ids.begin() + m);
-          node.data.lower[0] = t->first;
-          t = std::max_element(ids.begin() + l + 1, ids.begin() + m);
-          node.data.upper[0] = t->first;
-          // Use point with max distance as vantage point; this point act as a
-          // "corner" point and leads to a good partition.
+        int vp0, vp1,
+          m = partition(pts, dist, ids, cost, l, u, vp, 1, node, vp0, vp1);
+        if (vp0 >= 0)
           node.data.child[0] = init(pts, dist, bucket, tree, ids, cost,
-                                    l + 1, m, int(t - ids.begin()));
-        }
-        typename std::vector<item>::iterator
-          t = std::max_element(ids.begin() + m, ids.begin() + u);
-        node.data.lower[1] = ids[m].first;
-        node.data.upper[1] = t->first;
-        // Use point with max distance as vantage point here too
+                                    l + 1, m, vp0);
         node.data.child[1] = init(pts, dist, bucket, tree, ids, cost,
-                                  m, u, int(t - ids.begin()));
+                                  m, u, vp1);
       } else {
         if (bucket == 0)
           node.index = ids[l].second;
@@ -799,6 +1368,115 @@ namespace GeographicLib {
       return int(tree.size()) - 1;
     }
 
+    // Move the vantage point ids[vp] to ids[l] and partition ids[l+1, u)
+    // around the median distance m from it, which is returned.  Sets the
+    // index and bounds of node and the vantage points vp0 (-1 if the inner
+    // part is empty) and vp1 of the two parts.
+    static int partition(const std::vector<pos_t>& pts, const distfun_t& dist,
+                         std::vector<item>& ids, int& cost,
+                         int l, int u, int vp, int nthreads,
+                         Node& node, int& vp0, int& vp1) {
+      // choose a vantage point and move it to the start
+      std::swap(ids[l], ids[vp]);
+      const pos_t& p = pts[ids[l].second];
+
+      int m = (u + l + 1) / 2;
+
+      geographiclib_r::parallel_for(size_t(u - (l + 1)), nthreads,
+                                    [&](size_t k0, size_t k1) {
+        for (int k = l + 1 + int(k0); k < l + 1 + int(k1); ++k)
+          ids[k].first = dist(p, pts[ids[k].second]);
+      });
+      cost += u - (l + 1);
+      // partition around the median distance
+      std::nth_element(ids.begin() + l + 1,
+                       ids.begin() + m,
+                       ids.begin() + u);
+      node.index = ids[l].second;
+      vp0 = -1;
+      if (m > l + 1) {          // node.child[0] is possibly empty
+        typename std::vector<item>::iterator
+          t = std::min_element(ids.begin() + l + 1, ids.begin() + m);
+        node.data.lower[0] = t->first;
+        t = std::max_element(ids.begin() + l + 1, ids.begin() + m);
+        node.data.upper[0] = t->first;
+        // Use point with max distance as vantage point; this point act as a
+        // "corner" point and leads to a good partition.
+        vp0 = int(t - ids.begin());
+      }
+      typename std::vector<item>::iterator
+        t = std::max_element(ids.begin() + m, ids.begin() + u);
+      node.data.lower[1] = ids[m].first;
+      node.data.upper[1] = t->first;
+      // Use point with max distance as vantage point here too
+      vp1 = int(t - ids.begin());
+      return m;
+    }
+
+    // Split the node for ids[l, u), which has at least minparallel points,
+    // and its large descendants into splits, queueing the smaller subtrees
+    // below them in jobs.  Returns the handle of the node.
+    static int initsplit(const std::vector<pos_t>& pts, const distfun_t& dist,
+                         int bucket, std::vector<item>& ids, int& cost,
+                         int l, int u, int vp, int nthreads,
+                         std::vector<split>& splits, std::vector<job>& jobs) {
+      split s;
+      int vp0, vp1,
+        m = partition(pts, dist, ids, cost, l, u, vp, nthreads,
+                      s.node, vp0, vp1);
+      int lc[2] = {l + 1, m}, uc[2] = {m, u}, vpc[2] = {vp0, vp1};
+      for (int c = 0; c < 2; ++c) {
+        if (vpc[c] < 0)
+          s.child[c] = -1;
+        else if (uc[c] - lc[c] >= minparallel)
+          s.child[c] = initsplit(pts, dist, bucket, ids, cost,
+                                 lc[c], uc[c], vpc[c], nthreads,
+                                 splits, jobs);
+        else {
+          job j;
+          j.l = lc[c]; j.u = uc[c]; j.vp = vpc[c]; j.root = -1; j.cost = 0;
+          jobs.push_back(j);
+          s.child[c] = -2 - int(jobs.size() - 1);
+        }
+      }
+      splits.push_back(s);
+      return int(splits.size()) - 1;
+    }
+
+    // Append the subtree with handle h from initsplit() to tree in
+    // post-order and return the index of its root.
+    static int assemble(std::vector<Node>& tree,
+                        const std::vector<split>& splits,
+                        const std::vector<job>& jobs, int h) {
+      if (h == -1)
+        return -1;
+      if (h < -1) {
+        const job& j = jobs[-2 - h];
+        return append(tree, j.tree, j.root);
+      }
+      Node node = splits[h].node;
+      for (int c = 0; c < 2; ++c)
+        node.data.child[c] = assemble(tree, splits, jobs, splits[h].child[c]);
+      tree.push_back(node);
+      return int(tree.size()) - 1;
+    }
+
+    // Append the nodes of sub to tree, offsetting the child pointers, and
+    // return the new index of root (-1 stays -1).
+    static int append(std::vector<Node>& tree, const std::vector<Node>& sub,
+                      int root) {
+      if (root < 0) return -1;
+      int offset = int(tree.size());
+      for (const Node& node : sub) {
+        tree.push_back(node);
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (tree.back().data.child[l] >= 0)
+              tree.back().data.child[l] += offset;
+      }
+      return root + offset;
+    }
+
   };
 
 } // namespace GeographicLib
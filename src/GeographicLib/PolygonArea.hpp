@@ -166,6 +166,49 @@ namespace GeographicLib {
      **********************************************************************/
     void AddEdge(real azi, real s);
 
+    /**
+     * The running state of a PolygonAreaT: everything that AddPoint and
+     * AddEdge update.  Its members do not depend on \e GeodType.
+     **********************************************************************/
+    struct State {
+      unsigned num;             ///< number of points
+      int crossings;            ///< number of crossings of the prime meridian
+      real lat0, lon0;          ///< the first point
+      real lat1, lon1;          ///< the current point
+      real area[2];             ///< the two words of the area accumulator
+      real perimeter[2];        ///< the two words of the perimeter accumulator
+    };
+
+    /**
+     * Report the state of the polygon or polyline, e.g., for checkpointing.
+     *
+     * @return the State.
+     **********************************************************************/
+    State GetState() const {
+      State st;
+      st.num = _num; st.crossings = _crossings;
+      st.lat0 = _lat0; st.lon0 = _lon0; st.lat1 = _lat1; st.lon1 = _lon1;
+      _areasum.GetState(st.area[0], st.area[1]);
+      _perimetersum.GetState(st.perimeter[0], st.perimeter[1]);
+      return st;
+    }
+
+    /**
+     * Restore the polygon or polyline from a State given by GetState().
+     *
+     * @param[in] st the State.
+     *
+     * Points and edges added after this call give the same results as they
+     * would have given to the object that was saved, provided it used the
+     * same ellipsoid and the same value of \e polyline.
+     **********************************************************************/
+    void SetState(const State& st) {
+      _num = st.num; _crossings = st.crossings;
+      _lat0 = st.lat0; _lon0 = st.lon0; _lat1 = st.lat1; _lon1 = st.lon1;
+      _areasum.SetState(st.area[0], st.area[1]);
+      _perimetersum.SetState(st.perimeter[0], st.perimeter[1]);
+    }
+
     /**
      * Return the results so far.
      *
@@ -9,6 +9,9 @@
 
 #include <GeographicLib/Geohash.hpp>
 #include <GeographicLib/Utility.hpp>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace GeographicLib {
 
@@ -101,4 +104,137 @@ namespace GeographicLib {
     len = len1;
   }
 
+  unsigned long long Geohash::Spread(unsigned long long x) {
+    // Move bit k of a 32-bit x to bit 2k
+#if defined(__BMI2__)
+    return _pdep_u64(x, 0x5555555555555555ULL);
+#else
+    x &= 0xffffffffULL;
+    x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+    x = (x | (x <<  8)) & 0x00ff00ff00ff00ffULL;
+    x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x | (x <<  2)) & 0x3333333333333333ULL;
+    x = (x | (x <<  1)) & 0x5555555555555555ULL;
+    return x;
+#endif
+  }
+
+  unsigned long long Geohash::Compact(unsigned long long x) {
+    // The inverse of Spread: move bit 2k of x to bit k
+#if defined(__BMI2__)
+    return _pext_u64(x, 0x5555555555555555ULL);
+#else
+    x &= 0x5555555555555555ULL;
+    x = (x | (x >>  1)) & 0x3333333333333333ULL;
+    x = (x | (x >>  2)) & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x | (x >>  4)) & 0x00ff00ff00ff00ffULL;
+    x = (x | (x >>  8)) & 0x0000ffff0000ffffULL;
+    x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+    return x;
+#endif
+  }
+
+  void Geohash::ForwardInt(const real lat[], const real lon[], size_t n,
+                           int len, unsigned long long code[]) {
+    // The same quantization as Forward, keeping the top intbits_ bits of
+    // ulon and ulat and interleaving them with longitude first
+    static const real shift = ldexp(real(1), 45);
+    static const real loneps = Math::hd / shift;
+    static const real lateps = Math::qd / shift;
+    if (len < 1 || len > maxintlen_)
+      throw GeographicErr("Integer geohash length " + to_string(len)
+                          + " not in [1, " + to_string(maxintlen_) + "]");
+    const int drop = 46 - intbits_, s = 2 * intbits_ - 5 * len;
+    for (size_t i = 0; i < n; ++i) {
+      real la = lat[i], lo = lon[i];
+      if (fabs(la) > Math::qd)
+        throw GeographicErr("Latitude " + Utility::str(la)
+                            + "d not in [-" + to_string(Math::qd)
+                            + "d, " + to_string(Math::qd) + "d]");
+      if (isnan(la) || isnan(lo)) {
+        code[i] = invalidint_;
+        continue;
+      }
+      if (la == Math::qd) la -= lateps / 2;
+      lo = Math::AngNormalize(lo);
+      if (lo == Math::hd) lo = -Math::hd;
+      unsigned long long
+        ulon = (unsigned long long)(floor(lo/loneps) + shift) >> drop,
+        ulat = (unsigned long long)(floor(la/lateps) + shift) >> drop;
+      code[i] = ((Spread(ulon) << 1) | Spread(ulat)) >> s;
+    }
+  }
+
+  void Geohash::ReverseInt(const unsigned long long code[], size_t n, int len,
+                           real lat[], real lon[], bool centerp) {
+    // The bit counts and shifts of Reverse for a string of length len
+    static const real shift = ldexp(real(1), 45);
+    static const real loneps = Math::hd / shift;
+    static const real lateps = Math::qd / shift;
+    if (len < 1 || len > maxintlen_)
+      throw GeographicErr("Integer geohash length " + to_string(len)
+                          + " not in [1, " + to_string(maxintlen_) + "]");
+    const int
+      s = 2 * intbits_ - 5 * len,
+      nlon = (5 * len + 1) / 2, nlat = (5 * len) / 2,
+      t = 5 * (maxlen_ - len);
+    const unsigned long long top = 1ULL << (5 * len);
+    for (size_t i = 0; i < n; ++i) {
+      if (code[i] >= top) {
+        lat[i] = lon[i] = Math::NaN();
+        continue;
+      }
+      unsigned long long c = code[i] << s,
+        ulon = Compact(c >> 1) >> (intbits_ - nlon),
+        ulat = Compact(c) >> (intbits_ - nlat);
+      ulon <<= 1; ulat <<= 1;
+      if (centerp) {
+        ulon += 1;
+        ulat += 1;
+      }
+      ulon <<=     (t / 2);
+      ulat <<= t - (t / 2);
+      lon[i] = ulon * loneps - Math::hd;
+      lat[i] = ulat * lateps - Math::qd;
+    }
+  }
+
+  void Geohash::IntToString(unsigned long long code, int len,
+                            string& geohash) {
+    len = max(0, min(int(maxintlen_), len));
+    if (code >> (5 * len)) {
+      geohash = "invalid";
+      return;
+    }
+    geohash.resize(len);
+    for (int k = len; k--;) {
+      geohash[k] = lcdigits_[code & 31U];
+      code >>= 5;
+    }
+  }
+
+  unsigned long long Geohash::StringToInt(const string& geohash, int& len) {
+    int len1 = int(geohash.length());
+    if (len1 >= 3 &&
+        ((toupper(geohash[0]) == 'I' &&
+          toupper(geohash[1]) == 'N' &&
+          toupper(geohash[2]) == 'V') ||
+         (toupper(geohash[1]) == 'A' &&
+          toupper(geohash[0]) == 'N' &&
+          toupper(geohash[2]) == 'N')))
+      return invalidint_;
+    if (len1 > maxintlen_)
+      throw GeographicErr("Geohash " + geohash + " longer than "
+                          + to_string(maxintlen_) + " characters");
+    unsigned long long code = 0;
+    for (int k = 0; k < len1; ++k) {
+      int byte = Utility::lookup(ucdigits_, geohash[k]);
+      if (byte < 0)
+        throw GeographicErr("Illegal character in geohash " + geohash);
+      code = (code << 5) | unsigned(byte);
+    }
+    len = len1;
+    return code;
+  }
+
 } // namespace GeographicLib
@@ -43,6 +43,27 @@ namespace GeographicLib {
     }
   }
 
+  void Gnomonic::Forward(real lat0, real lon0,
+                         const real lat[], const real lon[], size_t n,
+                         real x[], real y[], real azi[], real rk[]) const {
+    const Geodesic::InverseOrigin org = _earth.InverseFrom(lat0, lon0);
+    for (size_t i = 0; i < n; ++i) {
+      real azi0, m, M, t;
+      org.GenInverse(lat[i], lon[i],
+                     Geodesic::AZIMUTH | Geodesic::REDUCEDLENGTH |
+                     Geodesic::GEODESICSCALE,
+                     t, azi0, azi[i], m, M, t, t);
+      rk[i] = M;
+      if (M <= 0)
+        x[i] = y[i] = Math::NaN();
+      else {
+        real rho = m/M;
+        Math::sincosd(azi0, x[i], y[i]);
+        x[i] *= rho; y[i] *= rho;
+      }
+    }
+  }
+
   void Gnomonic::Reverse(real lat0, real lon0, real x, real y,
                          real& lat, real& lon, real& azi, real& rk) const {
     real
@@ -59,4 +59,33 @@ namespace GeographicLib {
       MatrixMultiply(M);
   }
 
+  void LocalCartesian::Forward(const real lat[], const real lon[],
+                               const real h[], size_t n,
+                               real x[], real y[], real z[]) const {
+    _earth.Forward(lat, lon, h, n, x, y, z);
+    for (size_t i = 0; i < n; ++i) {
+      real
+        xc = x[i] - _x0, yc = y[i] - _y0, zc = z[i] - _z0;
+      x[i] = _r[0] * xc + _r[3] * yc + _r[6] * zc;
+      y[i] = _r[1] * xc + _r[4] * yc + _r[7] * zc;
+      z[i] = _r[2] * xc + _r[5] * yc + _r[8] * zc;
+    }
+  }
+
+  void LocalCartesian::Reverse(const real x[], const real y[], const real z[],
+                               size_t n,
+                               real lat[], real lon[], real h[]) const {
+    real xc[nblock_], yc[nblock_], zc[nblock_];
+    for (size_t i0 = 0; i0 < n; i0 += nblock_) {
+      size_t m = min(nblock_, n - i0);
+      for (size_t l = 0; l < m; ++l) {
+        size_t i = i0 + l;
+        xc[l] = _x0 + _r[0] * x[i] + _r[1] * y[i] + _r[2] * z[i];
+        yc[l] = _y0 + _r[3] * x[i] + _r[4] * y[i] + _r[5] * z[i];
+        zc[l] = _z0 + _r[6] * x[i] + _r[7] * y[i] + _r[8] * z[i];
+      }
+      _earth.Reverse(xc, yc, zc, m, lat + i0, lon + i0, h + i0);
+    }
+  }
+
 } // namespace GeographicLib
@@ -40,13 +40,22 @@ namespace GeographicLib {
 
   void MGRS::Forward(int zone, bool northp, real x, real y, real lat,
                      int prec, std::string& mgrs) {
+    char mgrs1[maxmgrslen_];
+    int mlen = Forward(zone, northp, x, y, lat, prec, mgrs1);
+    mgrs.resize(mlen);
+    copy(mgrs1, mgrs1 + mlen, mgrs.begin());
+  }
+
+  int MGRS::Forward(int zone, bool northp, real x, real y, real lat,
+                    int prec, char mgrs1[]) {
     // The smallest angle s.t., 90 - angeps() < 90 (approx 50e-12 arcsec)
     // 7 = ceil(log_2(90))
     static const real angeps = ldexp(real(1), -(Math::digits() - 7));
     if (zone == UTMUPS::INVALID ||
         isnan(x) || isnan(y) || isnan(lat)) {
-      mgrs = "INVALID";
-      return;
+      static const char invalid[] = "INVALID";
+      copy(invalid, invalid + 7, mgrs1);
+      return 7;
     }
     bool utmp = zone != 0;
     CheckCoords(utmp, northp, x, y);
@@ -56,9 +65,9 @@ namespace GeographicLib {
       throw GeographicErr("MGRS precision " + Utility::str(prec)
                           + " not in [-1, "
                           + Utility::str(int(maxprec_)) + "]");
-    // Fixed char array for accumulating string.  Allow space for zone, 3 block
-    // letters, easting + northing.  Don't need to allow for terminating null.
-    char mgrs1[2 + 3 + 2 * maxprec_];
+    // The caller's array accumulates the string.  It allows space for zone, 3
+    // block letters, easting + northing.  Don't need to allow for terminating
+    // null.
     int
       zone1 = zone - 1,
       z = utmp ? 2 : 0,
@@ -116,8 +125,7 @@ namespace GeographicLib {
         mgrs1[z + c + prec] = digits_[iy % base_]; iy /= base_;
       }
     }
-    mgrs.resize(mlen);
-    copy(mgrs1, mgrs1 + mlen, mgrs.begin());
+    return mlen;
   }
 
   void MGRS::Forward(int zone, bool northp, real x, real y,
@@ -158,9 +166,15 @@ namespace GeographicLib {
   void MGRS::Reverse(const string& mgrs,
                      int& zone, bool& northp, real& x, real& y,
                      int& prec, bool centerp) {
-    int
-      p = 0,
-      len = int(mgrs.length());
+    int gzdlen;
+    Reverse(mgrs.data(), int(mgrs.length()), zone, northp, x, y, prec, gzdlen,
+            centerp);
+  }
+
+  void MGRS::Reverse(const char* mgrs, int len,
+                     int& zone, bool& northp, real& x, real& y,
+                     int& prec, int& gzdlen, bool centerp) {
+    int p = 0;
     if (len >= 3 &&
         toupper(mgrs[0]) == 'I' &&
         toupper(mgrs[1]) == 'N' &&
@@ -169,6 +183,7 @@ namespace GeographicLib {
       northp = false;
       x = y = Math::NaN();
       prec = -2;
+      gzdlen = 3;
       return;
     }
     int zone1 = 0;
@@ -183,9 +198,9 @@ namespace GeographicLib {
       throw GeographicErr("Zone " + Utility::str(zone1) + " not in [1,60]");
     if (p > 2)
       throw GeographicErr("More than 2 digits at start of MGRS "
-                          + mgrs.substr(0, p));
+                          + string(mgrs, p));
     if (len - p < 1)
-      throw GeographicErr("MGRS string too short " + mgrs);
+      throw GeographicErr("MGRS string too short " + string(mgrs, len));
     bool utmp = zone1 != UTMUPS::UPS;
     int zonem1 = zone1 - 1;
     const char* band = utmp ? latband_ : upsband_;
@@ -213,16 +228,18 @@ namespace GeographicLib {
         y = upseasting_ * tile_;
       }
       prec = -1;
+      gzdlen = p;
       return;
     } else if (len - p < 2)
-      throw GeographicErr("Missing row letter in " + mgrs);
+      throw GeographicErr("Missing row letter in " + string(mgrs, len));
+    int gzdlen1 = p;
     const char* col = utmp ? utmcols_[zonem1 % 3] : upscols_[iband];
     const char* row = utmp ? utmrow_ : upsrows_[northp1];
     int icol = Utility::lookup(col, mgrs[p++]);
     if (icol < 0)
       throw GeographicErr("Column letter " + Utility::str(mgrs[p-1])
                           + " not in "
-                          + (utmp ? "zone " + mgrs.substr(0, p-2) :
+                          + (utmp ? "zone " + string(mgrs, p-2) :
                              "UPS band " + Utility::str(mgrs[p-2]))
                           + " set " + col );
     int irow = Utility::lookup(row, mgrs[p++]);
@@ -237,8 +254,8 @@ namespace GeographicLib {
       iband -= 10;
       irow = UTMRow(iband, icol, irow);
       if (irow == maxutmSrow_)
-        throw GeographicErr("Block " + mgrs.substr(p-2, 2)
-                            + " not in zone/band " + mgrs.substr(0, p-2));
+        throw GeographicErr("Block " + string(mgrs + p-2, 2)
+                            + " not in zone/band " + string(mgrs, p-2));
 
       irow = northp1 ? irow : irow + 100;
       icol = icol + minutmcol_;
@@ -258,20 +275,22 @@ namespace GeographicLib {
         ix = Utility::lookup(digits_, mgrs[p + i]),
         iy = Utility::lookup(digits_, mgrs[p + i + prec1]);
       if (ix < 0 || iy < 0)
-        throw GeographicErr("Encountered a non-digit in " + mgrs.substr(p));
+        throw GeographicErr("Encountered a non-digit in "
+                            + string(mgrs + p, len - p));
       x1 = base_ * x1 + ix;
       y1 = base_ * y1 + iy;
     }
     if ((len - p) % 2) {
       if (Utility::lookup(digits_, mgrs[len - 1]) < 0)
-        throw GeographicErr("Encountered a non-digit in " + mgrs.substr(p));
+        throw GeographicErr("Encountered a non-digit in "
+                            + string(mgrs + p, len - p));
       else
         throw GeographicErr("Not an even number of digits in "
-                            + mgrs.substr(p));
+                            + string(mgrs + p, len - p));
     }
     if (prec1 > maxprec_)
       throw GeographicErr("More than " + Utility::str(2*maxprec_)
-                          + " digits in " + mgrs.substr(p));
+                          + " digits in " + string(mgrs + p, len - p));
     if (centerp) {
       unit *= 2; x1 = 2 * x1 + 1; y1 = 2 * y1 + 1;
     }
@@ -280,6 +299,7 @@ namespace GeographicLib {
     x = (tile_ * x1) / unit;
     y = (tile_ * y1) / unit;
     prec = prec1;
+    gzdlen = gzdlen1;
   }
 
   void MGRS::CheckCoords(bool utmp, bool& northp, real& x, real& y) {
@@ -6,31 +6,31 @@
 #include <R_ext/Visibility.h>
 
 // 000_albers_geographiclib.cpp
-cpp11::writable::data_frame albers_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double stdlat1, double stdlat2, double k1);
-extern "C" SEXP _geographiclib_albers_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP stdlat1, SEXP stdlat2, SEXP k1) {
+cpp11::writable::data_frame albers_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double stdlat1, double stdlat2, double k1, int nthreads);
+extern "C" SEXP _geographiclib_albers_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP stdlat1, SEXP stdlat2, SEXP k1, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(albers_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1)));
+    return cpp11::as_sexp(albers_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_albers_geographiclib.cpp
-cpp11::writable::data_frame albers_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double stdlat1, double stdlat2, double k1);
-extern "C" SEXP _geographiclib_albers_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP stdlat1, SEXP stdlat2, SEXP k1) {
+cpp11::writable::data_frame albers_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double stdlat1, double stdlat2, double k1, int nthreads);
+extern "C" SEXP _geographiclib_albers_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP stdlat1, SEXP stdlat2, SEXP k1, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(albers_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1)));
+    return cpp11::as_sexp(albers_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_albers_geographiclib.cpp
-cpp11::writable::data_frame albers_fwd_single_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double stdlat, double k0);
-extern "C" SEXP _geographiclib_albers_fwd_single_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP stdlat, SEXP k0) {
+cpp11::writable::data_frame albers_fwd_single_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double stdlat, double k0, int nthreads);
+extern "C" SEXP _geographiclib_albers_fwd_single_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP stdlat, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(albers_fwd_single_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(albers_fwd_single_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_albers_geographiclib.cpp
-cpp11::writable::data_frame albers_rev_single_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double stdlat, double k0);
-extern "C" SEXP _geographiclib_albers_rev_single_cpp(SEXP x, SEXP y, SEXP lon0, SEXP stdlat, SEXP k0) {
+cpp11::writable::data_frame albers_rev_single_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double stdlat, double k0, int nthreads);
+extern "C" SEXP _geographiclib_albers_rev_single_cpp(SEXP x, SEXP y, SEXP lon0, SEXP stdlat, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(albers_rev_single_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(albers_rev_single_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_azimuthaleq_geographiclib.cpp
@@ -48,31 +48,31 @@ extern "C" SEXP _geographiclib_azimuthaleq_rev_cpp(SEXP x, SEXP y, SEXP lon0, SE
   END_CPP11
 }
 // 000_cassinisoldner_geographiclib.cpp
-cpp11::writable::data_frame cassini_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, double lon0, double lat0);
-extern "C" SEXP _geographiclib_cassini_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP lat0) {
+cpp11::writable::data_frame cassini_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, double lon0, double lat0, int nthreads);
+extern "C" SEXP _geographiclib_cassini_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP lat0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cassini_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0)));
+    return cpp11::as_sexp(cassini_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_cassinisoldner_geographiclib.cpp
-cpp11::writable::data_frame cassini_rev_cpp(cpp11::doubles x, cpp11::doubles y, double lon0, double lat0);
-extern "C" SEXP _geographiclib_cassini_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP lat0) {
+cpp11::writable::data_frame cassini_rev_cpp(cpp11::doubles x, cpp11::doubles y, double lon0, double lat0, int nthreads);
+extern "C" SEXP _geographiclib_cassini_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP lat0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cassini_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0)));
+    return cpp11::as_sexp(cassini_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_dms_geographiclib.cpp
-cpp11::writable::data_frame dms_decode_cpp(cpp11::strings input);
-extern "C" SEXP _geographiclib_dms_decode_cpp(SEXP input) {
+cpp11::writable::data_frame dms_decode_cpp(cpp11::strings input, int nthreads);
+extern "C" SEXP _geographiclib_dms_decode_cpp(SEXP input, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(dms_decode_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(input)));
+    return cpp11::as_sexp(dms_decode_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(input), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_dms_geographiclib.cpp
-cpp11::writable::data_frame dms_decode_latlon_cpp(cpp11::strings dmsa, cpp11::strings dmsb, cpp11::logicals longfirst);
-extern "C" SEXP _geographiclib_dms_decode_latlon_cpp(SEXP dmsa, SEXP dmsb, SEXP longfirst) {
+cpp11::writable::data_frame dms_decode_latlon_cpp(cpp11::strings dmsa, cpp11::strings dmsb, cpp11::logicals longfirst, int nthreads);
+extern "C" SEXP _geographiclib_dms_decode_latlon_cpp(SEXP dmsa, SEXP dmsb, SEXP longfirst, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(dms_decode_latlon_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(dmsa), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(dmsb), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(longfirst)));
+    return cpp11::as_sexp(dms_decode_latlon_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(dmsa), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(dmsb), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(longfirst), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_dms_geographiclib.cpp
@@ -174,17 +174,17 @@ extern "C" SEXP _geographiclib_gars_rev_cpp(SEXP gars) {
   END_CPP11
 }
 // 000_geocentric_geographiclib.cpp
-cpp11::writable::data_frame geocentric_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles h);
-extern "C" SEXP _geographiclib_geocentric_fwd_cpp(SEXP lon, SEXP lat, SEXP h) {
+cpp11::writable::data_frame geocentric_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles h, int nthreads);
+extern "C" SEXP _geographiclib_geocentric_fwd_cpp(SEXP lon, SEXP lat, SEXP h, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(geocentric_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(h)));
+    return cpp11::as_sexp(geocentric_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(h), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_geocentric_geographiclib.cpp
-cpp11::writable::data_frame geocentric_rev_cpp(cpp11::doubles X, cpp11::doubles Y, cpp11::doubles Z);
-extern "C" SEXP _geographiclib_geocentric_rev_cpp(SEXP X, SEXP Y, SEXP Z) {
+cpp11::writable::data_frame geocentric_rev_cpp(cpp11::doubles X, cpp11::doubles Y, cpp11::doubles Z, int nthreads);
+extern "C" SEXP _geographiclib_geocentric_rev_cpp(SEXP X, SEXP Y, SEXP Z, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(geocentric_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(X), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(Y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(Z)));
+    return cpp11::as_sexp(geocentric_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(X), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(Y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(Z), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_geocoords_geographiclib.cpp
@@ -223,10 +223,10 @@ extern "C" SEXP _geographiclib_geodesic_distance_fast_cpp(SEXP lon1, SEXP lat1,
   END_CPP11
 }
 // 000_geodesic_geographiclib.cpp
-cpp11::writable::doubles geodesic_distance_matrix_fast_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles lon2, cpp11::doubles lat2);
-extern "C" SEXP _geographiclib_geodesic_distance_matrix_fast_cpp(SEXP lon1, SEXP lat1, SEXP lon2, SEXP lat2) {
+cpp11::writable::doubles geodesic_distance_matrix_fast_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles lon2, cpp11::doubles lat2, bool symmetric, int nthreads);
+extern "C" SEXP _geographiclib_geodesic_distance_matrix_fast_cpp(SEXP lon1, SEXP lat1, SEXP lon2, SEXP lat2, SEXP symmetric, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(geodesic_distance_matrix_fast_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat2)));
+    return cpp11::as_sexp(geodesic_distance_matrix_fast_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat2), cpp11::as_cpp<cpp11::decay_t<bool>>(symmetric), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_geodesicexact_geographiclib.cpp
@@ -258,10 +258,10 @@ extern "C" SEXP _geographiclib_geodesic_line_cpp(SEXP lon1, SEXP lat1, SEXP azi1
   END_CPP11
 }
 // 000_geodesicexact_geographiclib.cpp
-cpp11::writable::doubles geodesic_distance_matrix_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles lon2, cpp11::doubles lat2);
-extern "C" SEXP _geographiclib_geodesic_distance_matrix_cpp(SEXP lon1, SEXP lat1, SEXP lon2, SEXP lat2) {
+cpp11::writable::doubles geodesic_distance_matrix_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles lon2, cpp11::doubles lat2, bool symmetric, int nthreads);
+extern "C" SEXP _geographiclib_geodesic_distance_matrix_cpp(SEXP lon1, SEXP lat1, SEXP lon2, SEXP lat2, SEXP symmetric, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(geodesic_distance_matrix_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat2)));
+    return cpp11::as_sexp(geodesic_distance_matrix_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat2), cpp11::as_cpp<cpp11::decay_t<bool>>(symmetric), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_geodesicexact_geographiclib.cpp
@@ -306,6 +306,76 @@ extern "C" SEXP _geographiclib_geohash_length_for_precisions_cpp(SEXP lat_resolu
     return cpp11::as_sexp(geohash_length_for_precisions_cpp(cpp11::as_cpp<cpp11::decay_t<double>>(lat_resolution), cpp11::as_cpp<cpp11::decay_t<double>>(lon_resolution)));
   END_CPP11
 }
+// 000_geohash_geographiclib.cpp
+cpp11::writable::doubles geohash_fwd_int_cpp(cpp11::doubles lon, cpp11::doubles lat, int len, bool int64, int nthreads);
+extern "C" SEXP _geographiclib_geohash_fwd_int_cpp(SEXP lon, SEXP lat, SEXP len, SEXP int64, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_fwd_int_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<int>>(len), cpp11::as_cpp<cpp11::decay_t<bool>>(int64), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_geohash_geographiclib.cpp
+cpp11::writable::data_frame geohash_rev_int_cpp(cpp11::doubles code, int len, bool int64, int nthreads);
+extern "C" SEXP _geographiclib_geohash_rev_int_cpp(SEXP code, SEXP len, SEXP int64, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_rev_int_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(code), cpp11::as_cpp<cpp11::decay_t<int>>(len), cpp11::as_cpp<cpp11::decay_t<bool>>(int64), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_geohash_geographiclib.cpp
+cpp11::writable::strings geohash_int_string_cpp(cpp11::doubles code, int len, bool int64);
+extern "C" SEXP _geographiclib_geohash_int_string_cpp(SEXP code, SEXP len, SEXP int64) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_int_string_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(code), cpp11::as_cpp<cpp11::decay_t<int>>(len), cpp11::as_cpp<cpp11::decay_t<bool>>(int64)));
+  END_CPP11
+}
+// 000_geohash_geographiclib.cpp
+cpp11::writable::data_frame geohash_neighbors_int_cpp(cpp11::doubles code, int len, bool int64, int nthreads);
+extern "C" SEXP _geographiclib_geohash_neighbors_int_cpp(SEXP code, SEXP len, SEXP int64, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_neighbors_int_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(code), cpp11::as_cpp<cpp11::decay_t<int>>(len), cpp11::as_cpp<cpp11::decay_t<bool>>(int64), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_geohash_geographiclib.cpp
+cpp11::writable::data_frame geohash_neighbors_cpp(cpp11::strings geohash);
+extern "C" SEXP _geographiclib_geohash_neighbors_cpp(SEXP geohash) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_neighbors_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(geohash)));
+  END_CPP11
+}
+// 000_geohash_geographiclib.cpp
+cpp11::writable::doubles geohash_cover_bbox_cpp(double xmin, double xmax, double ymin, double ymax, int len, bool int64);
+extern "C" SEXP _geographiclib_geohash_cover_bbox_cpp(SEXP xmin, SEXP xmax, SEXP ymin, SEXP ymax, SEXP len, SEXP int64) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_cover_bbox_cpp(cpp11::as_cpp<cpp11::decay_t<double>>(xmin), cpp11::as_cpp<cpp11::decay_t<double>>(xmax), cpp11::as_cpp<cpp11::decay_t<double>>(ymin), cpp11::as_cpp<cpp11::decay_t<double>>(ymax), cpp11::as_cpp<cpp11::decay_t<int>>(len), cpp11::as_cpp<cpp11::decay_t<bool>>(int64)));
+  END_CPP11
+}
+// 000_geohash_geographiclib.cpp
+cpp11::writable::data_frame geohash_cover_circle_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles radius, int len, bool int64, int nthreads);
+extern "C" SEXP _geographiclib_geohash_cover_circle_cpp(SEXP lon, SEXP lat, SEXP radius, SEXP len, SEXP int64, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geohash_cover_circle_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(radius), cpp11::as_cpp<cpp11::decay_t<int>>(len), cpp11::as_cpp<cpp11::decay_t<bool>>(int64), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_geometry_geographiclib.cpp
+cpp11::writable::data_frame geometry_area_cpp(cpp11::list x, bool wkb, bool rhumb, int nthreads);
+extern "C" SEXP _geographiclib_geometry_area_cpp(SEXP x, SEXP wkb, SEXP rhumb, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geometry_area_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(wkb), cpp11::as_cpp<cpp11::decay_t<bool>>(rhumb), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_geometry_geographiclib.cpp
+cpp11::writable::doubles geometry_length_cpp(cpp11::list x, bool wkb, bool rhumb, int nthreads);
+extern "C" SEXP _geographiclib_geometry_length_cpp(SEXP x, SEXP wkb, SEXP rhumb, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geometry_length_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(wkb), cpp11::as_cpp<cpp11::decay_t<bool>>(rhumb), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_geometry_geographiclib.cpp
+cpp11::writable::data_frame geometry_densify_cpp(cpp11::list x, bool wkb, double distance, bool rhumb, int nthreads);
+extern "C" SEXP _geographiclib_geometry_densify_cpp(SEXP x, SEXP wkb, SEXP distance, SEXP rhumb, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(geometry_densify_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(wkb), cpp11::as_cpp<cpp11::decay_t<double>>(distance), cpp11::as_cpp<cpp11::decay_t<bool>>(rhumb), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
 // 000_georef_geographiclib.cpp
 cpp11::writable::strings georef_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers precision);
 extern "C" SEXP _geographiclib_georef_fwd_cpp(SEXP lon, SEXP lat, SEXP precision) {
@@ -362,60 +432,67 @@ extern "C" SEXP _geographiclib_intersect_all_cpp(SEXP latX, SEXP lonX, SEXP aziX
     return cpp11::as_sexp(intersect_all_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(latX), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lonX), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(aziX), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(latY), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lonY), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(aziY), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(maxdist)));
   END_CPP11
 }
+// 000_intersect_geographiclib.cpp
+cpp11::writable::data_frame intersect_polylines_cpp(cpp11::doubles latX, cpp11::doubles lonX, cpp11::integers idX, cpp11::doubles latY, cpp11::doubles lonY, cpp11::integers idY, int nthreads);
+extern "C" SEXP _geographiclib_intersect_polylines_cpp(SEXP latX, SEXP lonX, SEXP idX, SEXP latY, SEXP lonY, SEXP idY, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(intersect_polylines_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(latX), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lonX), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(idX), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(latY), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lonY), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(idY), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
 // 000_lcc_geographiclib.cpp
-cpp11::writable::data_frame lcc_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, double lon0, double lat0, double stdlat, double k0);
-extern "C" SEXP _geographiclib_lcc_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP lat0, SEXP stdlat, SEXP k0) {
+cpp11::writable::data_frame lcc_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, double lon0, double lat0, double stdlat, double k0, int nthreads);
+extern "C" SEXP _geographiclib_lcc_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP lat0, SEXP stdlat, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(lcc_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(lcc_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_lcc_geographiclib.cpp
-cpp11::writable::data_frame lcc_fwd2_cpp(cpp11::doubles lon, cpp11::doubles lat, double lon0, double lat0, double stdlat1, double stdlat2, double k1);
-extern "C" SEXP _geographiclib_lcc_fwd2_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP lat0, SEXP stdlat1, SEXP stdlat2, SEXP k1) {
+cpp11::writable::data_frame lcc_fwd2_cpp(cpp11::doubles lon, cpp11::doubles lat, double lon0, double lat0, double stdlat1, double stdlat2, double k1, int nthreads);
+extern "C" SEXP _geographiclib_lcc_fwd2_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP lat0, SEXP stdlat1, SEXP stdlat2, SEXP k1, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(lcc_fwd2_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1)));
+    return cpp11::as_sexp(lcc_fwd2_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_lcc_geographiclib.cpp
-cpp11::writable::data_frame lcc_rev_cpp(cpp11::doubles x, cpp11::doubles y, double lon0, double lat0, double stdlat, double k0);
-extern "C" SEXP _geographiclib_lcc_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP lat0, SEXP stdlat, SEXP k0) {
+cpp11::writable::data_frame lcc_rev_cpp(cpp11::doubles x, cpp11::doubles y, double lon0, double lat0, double stdlat, double k0, int nthreads);
+extern "C" SEXP _geographiclib_lcc_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP lat0, SEXP stdlat, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(lcc_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(lcc_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_lcc_geographiclib.cpp
-cpp11::writable::data_frame lcc_rev2_cpp(cpp11::doubles x, cpp11::doubles y, double lon0, double lat0, double stdlat1, double stdlat2, double k1);
-extern "C" SEXP _geographiclib_lcc_rev2_cpp(SEXP x, SEXP y, SEXP lon0, SEXP lat0, SEXP stdlat1, SEXP stdlat2, SEXP k1) {
+cpp11::writable::data_frame lcc_rev2_cpp(cpp11::doubles x, cpp11::doubles y, double lon0, double lat0, double stdlat1, double stdlat2, double k1, int nthreads);
+extern "C" SEXP _geographiclib_lcc_rev2_cpp(SEXP x, SEXP y, SEXP lon0, SEXP lat0, SEXP stdlat1, SEXP stdlat2, SEXP k1, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(lcc_rev2_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1)));
+    return cpp11::as_sexp(lcc_rev2_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<double>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<double>>(k1), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_localcartesian_geographiclib.cpp
-cpp11::writable::data_frame localcartesian_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles h, double lon0, double lat0, double h0);
-extern "C" SEXP _geographiclib_localcartesian_fwd_cpp(SEXP lon, SEXP lat, SEXP h, SEXP lon0, SEXP lat0, SEXP h0) {
+cpp11::writable::data_frame localcartesian_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles h, double lon0, double lat0, double h0, int nthreads);
+extern "C" SEXP _geographiclib_localcartesian_fwd_cpp(SEXP lon, SEXP lat, SEXP h, SEXP lon0, SEXP lat0, SEXP h0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(localcartesian_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(h), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(h0)));
+    return cpp11::as_sexp(localcartesian_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(h), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(h0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_localcartesian_geographiclib.cpp
-cpp11::writable::data_frame localcartesian_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles z, double lon0, double lat0, double h0);
-extern "C" SEXP _geographiclib_localcartesian_rev_cpp(SEXP x, SEXP y, SEXP z, SEXP lon0, SEXP lat0, SEXP h0) {
+cpp11::writable::data_frame localcartesian_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles z, double lon0, double lat0, double h0, int nthreads);
+extern "C" SEXP _geographiclib_localcartesian_rev_cpp(SEXP x, SEXP y, SEXP z, SEXP lon0, SEXP lat0, SEXP h0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(localcartesian_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(z), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(h0)));
+    return cpp11::as_sexp(localcartesian_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(z), cpp11::as_cpp<cpp11::decay_t<double>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(lat0), cpp11::as_cpp<cpp11::decay_t<double>>(h0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_mgrs_geographiclib.cpp
-cpp11::strings mgrs_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers precision);
-extern "C" SEXP _geographiclib_mgrs_fwd_cpp(SEXP lon, SEXP lat, SEXP precision) {
+cpp11::writable::strings mgrs_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers precision, int nthreads);
+extern "C" SEXP _geographiclib_mgrs_fwd_cpp(SEXP lon, SEXP lat, SEXP precision, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(mgrs_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(precision)));
+    return cpp11::as_sexp(mgrs_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(precision), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_mgrs_geographiclib.cpp
-cpp11::writable::data_frame mgrs_rev_cpp(cpp11::strings mgrs);
-extern "C" SEXP _geographiclib_mgrs_rev_cpp(SEXP mgrs) {
+cpp11::writable::data_frame mgrs_rev_cpp(cpp11::strings mgrs, cpp11::strings columns, std::string crs, std::string designators, int nthreads);
+extern "C" SEXP _geographiclib_mgrs_rev_cpp(SEXP mgrs, SEXP columns, SEXP crs, SEXP designators, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(mgrs_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(mgrs)));
+    return cpp11::as_sexp(mgrs_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(mgrs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(columns), cpp11::as_cpp<cpp11::decay_t<std::string>>(crs), cpp11::as_cpp<cpp11::decay_t<std::string>>(designators), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_mgrs_geographiclib.cpp
@@ -426,31 +503,112 @@ extern "C" SEXP _geographiclib_mgrs_decode_cpp(SEXP mgrs) {
   END_CPP11
 }
 // 000_nn_geographiclib.cpp
-cpp11::writable::list nn_search_cpp(cpp11::doubles dataset_lat, cpp11::doubles dataset_lon, cpp11::doubles query_lat, cpp11::doubles query_lon, int k);
-extern "C" SEXP _geographiclib_nn_search_cpp(SEXP dataset_lat, SEXP dataset_lon, SEXP query_lat, SEXP query_lon, SEXP k) {
+cpp11::writable::list nn_search_cpp(cpp11::doubles dataset_lat, cpp11::doubles dataset_lon, cpp11::doubles query_lat, cpp11::doubles query_lon, int k, int nthreads);
+extern "C" SEXP _geographiclib_nn_search_cpp(SEXP dataset_lat, SEXP dataset_lon, SEXP query_lat, SEXP query_lon, SEXP k, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_search_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lon), cpp11::as_cpp<cpp11::decay_t<int>>(k), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+cpp11::writable::list nn_search_radius_cpp(cpp11::doubles dataset_lat, cpp11::doubles dataset_lon, cpp11::doubles query_lat, cpp11::doubles query_lon, double radius, bool csr, int nthreads);
+extern "C" SEXP _geographiclib_nn_search_radius_cpp(SEXP dataset_lat, SEXP dataset_lon, SEXP query_lat, SEXP query_lon, SEXP radius, SEXP csr, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_search_radius_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lon), cpp11::as_cpp<cpp11::decay_t<double>>(radius), cpp11::as_cpp<cpp11::decay_t<bool>>(csr), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+SEXP nn_index_build_cpp(cpp11::doubles dataset_lat, cpp11::doubles dataset_lon, bool kdtree, int nthreads);
+extern "C" SEXP _geographiclib_nn_index_build_cpp(SEXP dataset_lat, SEXP dataset_lon, SEXP kdtree, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_index_build_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lon), cpp11::as_cpp<cpp11::decay_t<bool>>(kdtree), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+int nn_index_size_cpp(SEXP index_ptr);
+extern "C" SEXP _geographiclib_nn_index_size_cpp(SEXP index_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_index_size_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+std::string nn_index_method_cpp(SEXP index_ptr);
+extern "C" SEXP _geographiclib_nn_index_method_cpp(SEXP index_ptr) {
   BEGIN_CPP11
-    return cpp11::as_sexp(nn_search_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lon), cpp11::as_cpp<cpp11::decay_t<int>>(k)));
+    return cpp11::as_sexp(nn_index_method_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr)));
   END_CPP11
 }
 // 000_nn_geographiclib.cpp
-cpp11::writable::list nn_search_radius_cpp(cpp11::doubles dataset_lat, cpp11::doubles dataset_lon, cpp11::doubles query_lat, cpp11::doubles query_lon, double radius);
-extern "C" SEXP _geographiclib_nn_search_radius_cpp(SEXP dataset_lat, SEXP dataset_lon, SEXP query_lat, SEXP query_lon, SEXP radius) {
+cpp11::writable::list nn_index_search_cpp(SEXP index_ptr, cpp11::doubles query_lat, cpp11::doubles query_lon, int k, int nthreads);
+extern "C" SEXP _geographiclib_nn_index_search_cpp(SEXP index_ptr, SEXP query_lat, SEXP query_lon, SEXP k, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(nn_search_radius_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(dataset_lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lon), cpp11::as_cpp<cpp11::decay_t<double>>(radius)));
+    return cpp11::as_sexp(nn_index_search_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lon), cpp11::as_cpp<cpp11::decay_t<int>>(k), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+cpp11::writable::list nn_index_search_radius_cpp(SEXP index_ptr, cpp11::doubles query_lat, cpp11::doubles query_lon, double radius, bool csr, int nthreads);
+extern "C" SEXP _geographiclib_nn_index_search_radius_cpp(SEXP index_ptr, SEXP query_lat, SEXP query_lon, SEXP radius, SEXP csr, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_index_search_radius_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(query_lon), cpp11::as_cpp<cpp11::decay_t<double>>(radius), cpp11::as_cpp<cpp11::decay_t<bool>>(csr), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+void nn_index_insert_cpp(SEXP index_ptr, cpp11::doubles lat, cpp11::doubles lon, int nthreads);
+extern "C" SEXP _geographiclib_nn_index_insert_cpp(SEXP index_ptr, SEXP lat, SEXP lon, SEXP nthreads) {
+  BEGIN_CPP11
+    nn_index_insert_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads));
+    return R_NilValue;
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+void nn_index_remove_cpp(SEXP index_ptr, cpp11::integers idx, int nthreads);
+extern "C" SEXP _geographiclib_nn_index_remove_cpp(SEXP index_ptr, SEXP idx, SEXP nthreads) {
+  BEGIN_CPP11
+    nn_index_remove_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(idx), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads));
+    return R_NilValue;
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+void nn_index_compact_cpp(SEXP index_ptr, int nthreads);
+extern "C" SEXP _geographiclib_nn_index_compact_cpp(SEXP index_ptr, SEXP nthreads) {
+  BEGIN_CPP11
+    nn_index_compact_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads));
+    return R_NilValue;
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+cpp11::writable::list nn_index_stats_cpp(SEXP index_ptr);
+extern "C" SEXP _geographiclib_nn_index_stats_cpp(SEXP index_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_index_stats_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr)));
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+void nn_index_save_cpp(SEXP index_ptr, std::string path);
+extern "C" SEXP _geographiclib_nn_index_save_cpp(SEXP index_ptr, SEXP path) {
+  BEGIN_CPP11
+    nn_index_save_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(index_ptr), cpp11::as_cpp<cpp11::decay_t<std::string>>(path));
+    return R_NilValue;
+  END_CPP11
+}
+// 000_nn_geographiclib.cpp
+SEXP nn_index_load_cpp(std::string path);
+extern "C" SEXP _geographiclib_nn_index_load_cpp(SEXP path) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nn_index_load_cpp(cpp11::as_cpp<cpp11::decay_t<std::string>>(path)));
   END_CPP11
 }
 // 000_osgb_geographiclib.cpp
-cpp11::writable::data_frame osgb_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat);
-extern "C" SEXP _geographiclib_osgb_fwd_cpp(SEXP lon, SEXP lat) {
+cpp11::writable::data_frame osgb_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, int nthreads);
+extern "C" SEXP _geographiclib_osgb_fwd_cpp(SEXP lon, SEXP lat, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(osgb_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat)));
+    return cpp11::as_sexp(osgb_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_osgb_geographiclib.cpp
-cpp11::writable::data_frame osgb_rev_cpp(cpp11::doubles easting, cpp11::doubles northing);
-extern "C" SEXP _geographiclib_osgb_rev_cpp(SEXP easting, SEXP northing) {
+cpp11::writable::data_frame osgb_rev_cpp(cpp11::doubles easting, cpp11::doubles northing, int nthreads);
+extern "C" SEXP _geographiclib_osgb_rev_cpp(SEXP easting, SEXP northing, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(osgb_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(easting), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(northing)));
+    return cpp11::as_sexp(osgb_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(easting), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(northing), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_osgb_geographiclib.cpp
@@ -467,39 +625,61 @@ extern "C" SEXP _geographiclib_osgb_gridref_rev_cpp(SEXP gridref) {
     return cpp11::as_sexp(osgb_gridref_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(gridref)));
   END_CPP11
 }
+// 000_parallel_geographiclib.cpp
+int parallel_threads_cpp(int nthreads);
+extern "C" SEXP _geographiclib_parallel_threads_cpp(SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(parallel_threads_cpp(cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_parallel_geographiclib.cpp
+int parallel_grain_size_cpp(int grain);
+extern "C" SEXP _geographiclib_parallel_grain_size_cpp(SEXP grain) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(parallel_grain_size_cpp(cpp11::as_cpp<cpp11::decay_t<int>>(grain)));
+  END_CPP11
+}
+// 000_parallel_geographiclib.cpp
+void parallel_shutdown_cpp();
+extern "C" SEXP _geographiclib_parallel_shutdown_cpp() {
+  BEGIN_CPP11
+    parallel_shutdown_cpp();
+    return R_NilValue;
+  END_CPP11
+}
 // 000_polarstereo_geographiclib.cpp
-cpp11::writable::data_frame polarstereo_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::logicals northp, double k0);
-extern "C" SEXP _geographiclib_polarstereo_fwd_cpp(SEXP lon, SEXP lat, SEXP northp, SEXP k0) {
+cpp11::writable::data_frame polarstereo_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::logicals northp, double k0, int nthreads);
+extern "C" SEXP _geographiclib_polarstereo_fwd_cpp(SEXP lon, SEXP lat, SEXP northp, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(polarstereo_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(polarstereo_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_polarstereo_geographiclib.cpp
-cpp11::writable::data_frame polarstereo_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::logicals northp, double k0);
-extern "C" SEXP _geographiclib_polarstereo_rev_cpp(SEXP x, SEXP y, SEXP northp, SEXP k0) {
+cpp11::writable::data_frame polarstereo_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::logicals northp, double k0, int nthreads);
+extern "C" SEXP _geographiclib_polarstereo_rev_cpp(SEXP x, SEXP y, SEXP northp, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(polarstereo_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(polarstereo_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_polarstereo_geographiclib.cpp
-cpp11::writable::data_frame polarstereo_fwd_custom_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::logicals northp, double k0);
-extern "C" SEXP _geographiclib_polarstereo_fwd_custom_cpp(SEXP lon, SEXP lat, SEXP northp, SEXP k0) {
+cpp11::writable::data_frame polarstereo_fwd_custom_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::logicals northp, double k0, int nthreads);
+extern "C" SEXP _geographiclib_polarstereo_fwd_custom_cpp(SEXP lon, SEXP lat, SEXP northp, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(polarstereo_fwd_custom_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(polarstereo_fwd_custom_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_polarstereo_geographiclib.cpp
-cpp11::writable::data_frame polarstereo_rev_custom_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::logicals northp, double k0);
-extern "C" SEXP _geographiclib_polarstereo_rev_custom_cpp(SEXP x, SEXP y, SEXP northp, SEXP k0) {
+cpp11::writable::data_frame polarstereo_rev_custom_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::logicals northp, double k0, int nthreads);
+extern "C" SEXP _geographiclib_polarstereo_rev_custom_cpp(SEXP x, SEXP y, SEXP northp, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(polarstereo_rev_custom_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(polarstereo_rev_custom_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_polygonarea_geographiclib.cpp
-cpp11::writable::data_frame polygonarea_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers id, bool polyline);
-extern "C" SEXP _geographiclib_polygonarea_cpp(SEXP lon, SEXP lat, SEXP id, SEXP polyline) {
+cpp11::writable::data_frame polygonarea_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers id, cpp11::integers part, cpp11::integers ring, bool polyline, int nthreads);
+extern "C" SEXP _geographiclib_polygonarea_cpp(SEXP lon, SEXP lat, SEXP id, SEXP part, SEXP ring, SEXP polyline, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(polygonarea_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(id), cpp11::as_cpp<cpp11::decay_t<bool>>(polyline)));
+    return cpp11::as_sexp(polygonarea_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(id), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(part), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(ring), cpp11::as_cpp<cpp11::decay_t<bool>>(polyline), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_polygonarea_geographiclib.cpp
@@ -516,6 +696,91 @@ extern "C" SEXP _geographiclib_polygonarea_cumulative_cpp(SEXP lon, SEXP lat, SE
     return cpp11::as_sexp(polygonarea_cumulative_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<bool>>(polyline)));
   END_CPP11
 }
+// 000_polygonarea_geographiclib.cpp
+SEXP polygon_accumulator_new_cpp(bool polyline, bool rhumb);
+extern "C" SEXP _geographiclib_polygon_accumulator_new_cpp(SEXP polyline, SEXP rhumb) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(polygon_accumulator_new_cpp(cpp11::as_cpp<cpp11::decay_t<bool>>(polyline), cpp11::as_cpp<cpp11::decay_t<bool>>(rhumb)));
+  END_CPP11
+}
+// 000_polygonarea_geographiclib.cpp
+void polygon_accumulator_add_cpp(SEXP acc_ptr, cpp11::doubles lon, cpp11::doubles lat, cpp11::integers id, int nthreads);
+extern "C" SEXP _geographiclib_polygon_accumulator_add_cpp(SEXP acc_ptr, SEXP lon, SEXP lat, SEXP id, SEXP nthreads) {
+  BEGIN_CPP11
+    polygon_accumulator_add_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(acc_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(id), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads));
+    return R_NilValue;
+  END_CPP11
+}
+// 000_polygonarea_geographiclib.cpp
+cpp11::writable::data_frame polygon_accumulator_result_cpp(SEXP acc_ptr, cpp11::integers id, bool remove);
+extern "C" SEXP _geographiclib_polygon_accumulator_result_cpp(SEXP acc_ptr, SEXP id, SEXP remove) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(polygon_accumulator_result_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(acc_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(id), cpp11::as_cpp<cpp11::decay_t<bool>>(remove)));
+  END_CPP11
+}
+// 000_polygonarea_geographiclib.cpp
+cpp11::writable::data_frame polygon_accumulator_snapshot_cpp(SEXP acc_ptr);
+extern "C" SEXP _geographiclib_polygon_accumulator_snapshot_cpp(SEXP acc_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(polygon_accumulator_snapshot_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(acc_ptr)));
+  END_CPP11
+}
+// 000_polygonarea_geographiclib.cpp
+SEXP polygon_accumulator_restore_cpp(cpp11::integers id, cpp11::integers n, cpp11::integers crossings, cpp11::doubles lat0, cpp11::doubles lon0, cpp11::doubles lat1, cpp11::doubles lon1, cpp11::doubles area_s, cpp11::doubles area_t, cpp11::doubles perimeter_s, cpp11::doubles perimeter_t, bool polyline, bool rhumb);
+extern "C" SEXP _geographiclib_polygon_accumulator_restore_cpp(SEXP id, SEXP n, SEXP crossings, SEXP lat0, SEXP lon0, SEXP lat1, SEXP lon1, SEXP area_s, SEXP area_t, SEXP perimeter_s, SEXP perimeter_t, SEXP polyline, SEXP rhumb) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(polygon_accumulator_restore_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(id), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(n), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(crossings), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat0), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(area_s), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(area_t), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(perimeter_s), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(perimeter_t), cpp11::as_cpp<cpp11::decay_t<bool>>(polyline), cpp11::as_cpp<cpp11::decay_t<bool>>(rhumb)));
+  END_CPP11
+}
+// 000_polygonarea_geographiclib.cpp
+int polygon_accumulator_size_cpp(SEXP acc_ptr);
+extern "C" SEXP _geographiclib_polygon_accumulator_size_cpp(SEXP acc_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(polygon_accumulator_size_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(acc_ptr)));
+  END_CPP11
+}
+// 000_polygonarea_geographiclib.cpp
+cpp11::writable::list polygon_validity_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::integers id, cpp11::integers ring, int nthreads);
+extern "C" SEXP _geographiclib_polygon_validity_cpp(SEXP lon, SEXP lat, SEXP id, SEXP ring, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(polygon_validity_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(id), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(ring), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_projection_geographiclib.cpp
+SEXP projection_create_cpp(std::string type, double a, double f, cpp11::doubles stdlat, double k, bool exact);
+extern "C" SEXP _geographiclib_projection_create_cpp(SEXP type, SEXP a, SEXP f, SEXP stdlat, SEXP k, SEXP exact) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(projection_create_cpp(cpp11::as_cpp<cpp11::decay_t<std::string>>(type), cpp11::as_cpp<cpp11::decay_t<double>>(a), cpp11::as_cpp<cpp11::decay_t<double>>(f), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(stdlat), cpp11::as_cpp<cpp11::decay_t<double>>(k), cpp11::as_cpp<cpp11::decay_t<bool>>(exact)));
+  END_CPP11
+}
+// 000_projection_geographiclib.cpp
+bool projection_valid_cpp(SEXP proj_ptr);
+extern "C" SEXP _geographiclib_projection_valid_cpp(SEXP proj_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(projection_valid_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(proj_ptr)));
+  END_CPP11
+}
+// 000_projection_geographiclib.cpp
+cpp11::writable::list projection_info_cpp(SEXP proj_ptr);
+extern "C" SEXP _geographiclib_projection_info_cpp(SEXP proj_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(projection_info_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(proj_ptr)));
+  END_CPP11
+}
+// 000_projection_geographiclib.cpp
+cpp11::writable::data_frame projection_fwd_cpp(SEXP proj_ptr, cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, cpp11::logicals northp, int nthreads);
+extern "C" SEXP _geographiclib_projection_fwd_cpp(SEXP proj_ptr, SEXP lon, SEXP lat, SEXP lon0, SEXP northp, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(projection_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(proj_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_projection_geographiclib.cpp
+cpp11::writable::data_frame projection_rev_cpp(SEXP proj_ptr, cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, cpp11::logicals northp, int nthreads);
+extern "C" SEXP _geographiclib_projection_rev_cpp(SEXP proj_ptr, SEXP x, SEXP y, SEXP lon0, SEXP northp, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(projection_rev_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(proj_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
 // 000_rhumb_geographiclib.cpp
 cpp11::writable::data_frame rhumb_direct_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles azi12, cpp11::doubles s12);
 extern "C" SEXP _geographiclib_rhumb_direct_cpp(SEXP lon1, SEXP lat1, SEXP azi12, SEXP s12) {
@@ -552,70 +817,98 @@ extern "C" SEXP _geographiclib_rhumb_distance_pairwise_cpp(SEXP lon1, SEXP lat1,
   END_CPP11
 }
 // 000_rhumb_geographiclib.cpp
-cpp11::writable::doubles rhumb_distance_matrix_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles lon2, cpp11::doubles lat2);
-extern "C" SEXP _geographiclib_rhumb_distance_matrix_cpp(SEXP lon1, SEXP lat1, SEXP lon2, SEXP lat2) {
+cpp11::writable::doubles rhumb_distance_matrix_cpp(cpp11::doubles lon1, cpp11::doubles lat1, cpp11::doubles lon2, cpp11::doubles lat2, bool symmetric);
+extern "C" SEXP _geographiclib_rhumb_distance_matrix_cpp(SEXP lon1, SEXP lat1, SEXP lon2, SEXP lat2, SEXP symmetric) {
   BEGIN_CPP11
-    return cpp11::as_sexp(rhumb_distance_matrix_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat2)));
+    return cpp11::as_sexp(rhumb_distance_matrix_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat2), cpp11::as_cpp<cpp11::decay_t<bool>>(symmetric)));
   END_CPP11
 }
 // 000_tm_geographiclib.cpp
-cpp11::writable::data_frame tm_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double k0);
-extern "C" SEXP _geographiclib_tm_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP k0) {
+cpp11::writable::data_frame tm_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double k0, int nthreads);
+extern "C" SEXP _geographiclib_tm_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(tm_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(tm_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_tm_geographiclib.cpp
-cpp11::writable::data_frame tm_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double k0);
-extern "C" SEXP _geographiclib_tm_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP k0) {
+cpp11::writable::data_frame tm_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double k0, int nthreads);
+extern "C" SEXP _geographiclib_tm_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(tm_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(tm_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_tm_geographiclib.cpp
-cpp11::writable::data_frame tm_exact_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double k0);
-extern "C" SEXP _geographiclib_tm_exact_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP k0) {
+cpp11::writable::data_frame tm_exact_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::doubles lon0, double k0, int nthreads);
+extern "C" SEXP _geographiclib_tm_exact_fwd_cpp(SEXP lon, SEXP lat, SEXP lon0, SEXP k0, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(tm_exact_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(tm_exact_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_tm_geographiclib.cpp
-cpp11::writable::data_frame tm_exact_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double k0);
-extern "C" SEXP _geographiclib_tm_exact_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP k0) {
+cpp11::writable::data_frame tm_exact_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::doubles lon0, double k0, int nthreads);
+extern "C" SEXP _geographiclib_tm_exact_rev_cpp(SEXP x, SEXP y, SEXP lon0, SEXP k0, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(tm_exact_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_transform_geographiclib.cpp
+SEXP transform_create_cpp(cpp11::strings type, cpp11::doubles a, cpp11::doubles f, cpp11::doubles lat0, cpp11::doubles lon0, cpp11::doubles h0, cpp11::doubles stdlat1, cpp11::doubles stdlat2, cpp11::doubles k0, cpp11::integers zone, cpp11::logicals northp, cpp11::logicals exact);
+extern "C" SEXP _geographiclib_transform_create_cpp(SEXP type, SEXP a, SEXP f, SEXP lat0, SEXP lon0, SEXP h0, SEXP stdlat1, SEXP stdlat2, SEXP k0, SEXP zone, SEXP northp, SEXP exact) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(transform_create_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(type), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(a), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(f), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat0), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(h0), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(stdlat1), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(stdlat2), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(k0), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(zone), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(exact)));
+  END_CPP11
+}
+// 000_transform_geographiclib.cpp
+bool transform_valid_cpp(SEXP tr_ptr);
+extern "C" SEXP _geographiclib_transform_valid_cpp(SEXP tr_ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(transform_valid_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(tr_ptr)));
+  END_CPP11
+}
+// 000_transform_geographiclib.cpp
+cpp11::writable::data_frame transform_apply_cpp(SEXP tr_ptr, cpp11::doubles x, cpp11::doubles y, cpp11::doubles z, int nthreads);
+extern "C" SEXP _geographiclib_transform_apply_cpp(SEXP tr_ptr, SEXP x, SEXP y, SEXP z, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(transform_apply_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(tr_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(z), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// 000_transform_geographiclib.cpp
+cpp11::writable::data_frame transform_grid_cpp(SEXP tr_ptr, cpp11::doubles extent, cpp11::integers dimension, double tolerance, bool cubic, int step, int nthreads);
+extern "C" SEXP _geographiclib_transform_grid_cpp(SEXP tr_ptr, SEXP extent, SEXP dimension, SEXP tolerance, SEXP cubic, SEXP step, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(tm_exact_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon0), cpp11::as_cpp<cpp11::decay_t<double>>(k0)));
+    return cpp11::as_sexp(transform_grid_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(tr_ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(extent), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(dimension), cpp11::as_cpp<cpp11::decay_t<double>>(tolerance), cpp11::as_cpp<cpp11::decay_t<bool>>(cubic), cpp11::as_cpp<cpp11::decay_t<int>>(step), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_utm_ups.cpp
-cpp11::writable::data_frame utmups_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat);
-extern "C" SEXP _geographiclib_utmups_fwd_cpp(SEXP lon, SEXP lat) {
+cpp11::writable::data_frame utmups_fwd_cpp(cpp11::doubles lon, cpp11::doubles lat, cpp11::strings columns, std::string crs, int nthreads);
+extern "C" SEXP _geographiclib_utmups_fwd_cpp(SEXP lon, SEXP lat, SEXP columns, SEXP crs, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(utmups_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat)));
+    return cpp11::as_sexp(utmups_fwd_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(columns), cpp11::as_cpp<cpp11::decay_t<std::string>>(crs), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // 000_utm_ups.cpp
-cpp11::writable::data_frame utmups_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::integers zone, cpp11::logicals northp);
-extern "C" SEXP _geographiclib_utmups_rev_cpp(SEXP x, SEXP y, SEXP zone, SEXP northp) {
+cpp11::writable::data_frame utmups_rev_cpp(cpp11::doubles x, cpp11::doubles y, cpp11::integers zone, cpp11::logicals northp, cpp11::strings columns, std::string crs, int nthreads);
+extern "C" SEXP _geographiclib_utmups_rev_cpp(SEXP x, SEXP y, SEXP zone, SEXP northp, SEXP columns, SEXP crs, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(utmups_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(zone), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp)));
+    return cpp11::as_sexp(utmups_rev_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(zone), cpp11::as_cpp<cpp11::decay_t<cpp11::logicals>>(northp), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(columns), cpp11::as_cpp<cpp11::decay_t<std::string>>(crs), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
-    {"_geographiclib_albers_fwd_cpp",                    (DL_FUNC) &_geographiclib_albers_fwd_cpp,                    6},
-    {"_geographiclib_albers_fwd_single_cpp",             (DL_FUNC) &_geographiclib_albers_fwd_single_cpp,             5},
-    {"_geographiclib_albers_rev_cpp",                    (DL_FUNC) &_geographiclib_albers_rev_cpp,                    6},
-    {"_geographiclib_albers_rev_single_cpp",             (DL_FUNC) &_geographiclib_albers_rev_single_cpp,             5},
+    {"_geographiclib_albers_fwd_cpp",                    (DL_FUNC) &_geographiclib_albers_fwd_cpp,                    7},
+    {"_geographiclib_albers_fwd_single_cpp",             (DL_FUNC) &_geographiclib_albers_fwd_single_cpp,             6},
+    {"_geographiclib_albers_rev_cpp",                    (DL_FUNC) &_geographiclib_albers_rev_cpp,                    7},
+    {"_geographiclib_albers_rev_single_cpp",             (DL_FUNC) &_geographiclib_albers_rev_single_cpp,             6},
     {"_geographiclib_azimuthaleq_fwd_cpp",               (DL_FUNC) &_geographiclib_azimuthaleq_fwd_cpp,               4},
     {"_geographiclib_azimuthaleq_rev_cpp",               (DL_FUNC) &_geographiclib_azimuthaleq_rev_cpp,               4},
-    {"_geographiclib_cassini_fwd_cpp",                   (DL_FUNC) &_geographiclib_cassini_fwd_cpp,                   4},
-    {"_geographiclib_cassini_rev_cpp",                   (DL_FUNC) &_geographiclib_cassini_rev_cpp,                   4},
+    {"_geographiclib_cassini_fwd_cpp",                   (DL_FUNC) &_geographiclib_cassini_fwd_cpp,                   5},
+    {"_geographiclib_cassini_rev_cpp",                   (DL_FUNC) &_geographiclib_cassini_rev_cpp,                   5},
     {"_geographiclib_dms_combine_cpp",                   (DL_FUNC) &_geographiclib_dms_combine_cpp,                   3},
     {"_geographiclib_dms_decode_angle_cpp",              (DL_FUNC) &_geographiclib_dms_decode_angle_cpp,              1},
     {"_geographiclib_dms_decode_azimuth_cpp",            (DL_FUNC) &_geographiclib_dms_decode_azimuth_cpp,            1},
-    {"_geographiclib_dms_decode_cpp",                    (DL_FUNC) &_geographiclib_dms_decode_cpp,                    1},
-    {"_geographiclib_dms_decode_latlon_cpp",             (DL_FUNC) &_geographiclib_dms_decode_latlon_cpp,             3},
+    {"_geographiclib_dms_decode_cpp",                    (DL_FUNC) &_geographiclib_dms_decode_cpp,                    2},
+    {"_geographiclib_dms_decode_latlon_cpp",             (DL_FUNC) &_geographiclib_dms_decode_latlon_cpp,             4},
     {"_geographiclib_dms_encode_auto_cpp",               (DL_FUNC) &_geographiclib_dms_encode_auto_cpp,               4},
     {"_geographiclib_dms_encode_cpp",                    (DL_FUNC) &_geographiclib_dms_encode_cpp,                    5},
     {"_geographiclib_dms_split_dm_cpp",                  (DL_FUNC) &_geographiclib_dms_split_dm_cpp,                  1},
@@ -627,25 +920,35 @@ static const R_CallMethodDef CallEntries[] = {
     {"_geographiclib_ellipsoid_params_cpp",              (DL_FUNC) &_geographiclib_ellipsoid_params_cpp,              0},
     {"_geographiclib_gars_fwd_cpp",                      (DL_FUNC) &_geographiclib_gars_fwd_cpp,                      3},
     {"_geographiclib_gars_rev_cpp",                      (DL_FUNC) &_geographiclib_gars_rev_cpp,                      1},
-    {"_geographiclib_geocentric_fwd_cpp",                (DL_FUNC) &_geographiclib_geocentric_fwd_cpp,                3},
-    {"_geographiclib_geocentric_rev_cpp",                (DL_FUNC) &_geographiclib_geocentric_rev_cpp,                3},
+    {"_geographiclib_geocentric_fwd_cpp",                (DL_FUNC) &_geographiclib_geocentric_fwd_cpp,                4},
+    {"_geographiclib_geocentric_rev_cpp",                (DL_FUNC) &_geographiclib_geocentric_rev_cpp,                4},
     {"_geographiclib_geocoords_parse_cpp",               (DL_FUNC) &_geographiclib_geocoords_parse_cpp,               1},
     {"_geographiclib_geodesic_direct_cpp",               (DL_FUNC) &_geographiclib_geodesic_direct_cpp,               4},
     {"_geographiclib_geodesic_direct_fast_cpp",          (DL_FUNC) &_geographiclib_geodesic_direct_fast_cpp,          4},
     {"_geographiclib_geodesic_distance_fast_cpp",        (DL_FUNC) &_geographiclib_geodesic_distance_fast_cpp,        4},
-    {"_geographiclib_geodesic_distance_matrix_cpp",      (DL_FUNC) &_geographiclib_geodesic_distance_matrix_cpp,      4},
-    {"_geographiclib_geodesic_distance_matrix_fast_cpp", (DL_FUNC) &_geographiclib_geodesic_distance_matrix_fast_cpp, 4},
+    {"_geographiclib_geodesic_distance_matrix_cpp",      (DL_FUNC) &_geographiclib_geodesic_distance_matrix_cpp,      6},
+    {"_geographiclib_geodesic_distance_matrix_fast_cpp", (DL_FUNC) &_geographiclib_geodesic_distance_matrix_fast_cpp, 6},
     {"_geographiclib_geodesic_distance_pairwise_cpp",    (DL_FUNC) &_geographiclib_geodesic_distance_pairwise_cpp,    4},
     {"_geographiclib_geodesic_inverse_cpp",              (DL_FUNC) &_geographiclib_geodesic_inverse_cpp,              4},
     {"_geographiclib_geodesic_inverse_fast_cpp",         (DL_FUNC) &_geographiclib_geodesic_inverse_fast_cpp,         4},
     {"_geographiclib_geodesic_line_cpp",                 (DL_FUNC) &_geographiclib_geodesic_line_cpp,                 4},
     {"_geographiclib_geodesic_path_cpp",                 (DL_FUNC) &_geographiclib_geodesic_path_cpp,                 5},
     {"_geographiclib_geodesic_path_fast_cpp",            (DL_FUNC) &_geographiclib_geodesic_path_fast_cpp,            5},
+    {"_geographiclib_geohash_cover_bbox_cpp",            (DL_FUNC) &_geographiclib_geohash_cover_bbox_cpp,            6},
+    {"_geographiclib_geohash_cover_circle_cpp",          (DL_FUNC) &_geographiclib_geohash_cover_circle_cpp,          6},
     {"_geographiclib_geohash_fwd_cpp",                   (DL_FUNC) &_geographiclib_geohash_fwd_cpp,                   3},
+    {"_geographiclib_geohash_fwd_int_cpp",               (DL_FUNC) &_geographiclib_geohash_fwd_int_cpp,               5},
+    {"_geographiclib_geohash_int_string_cpp",            (DL_FUNC) &_geographiclib_geohash_int_string_cpp,            3},
     {"_geographiclib_geohash_length_for_precision_cpp",  (DL_FUNC) &_geographiclib_geohash_length_for_precision_cpp,  1},
     {"_geographiclib_geohash_length_for_precisions_cpp", (DL_FUNC) &_geographiclib_geohash_length_for_precisions_cpp, 2},
+    {"_geographiclib_geohash_neighbors_cpp",             (DL_FUNC) &_geographiclib_geohash_neighbors_cpp,             1},
+    {"_geographiclib_geohash_neighbors_int_cpp",         (DL_FUNC) &_geographiclib_geohash_neighbors_int_cpp,         4},
     {"_geographiclib_geohash_resolution_cpp",            (DL_FUNC) &_geographiclib_geohash_resolution_cpp,            1},
     {"_geographiclib_geohash_rev_cpp",                   (DL_FUNC) &_geographiclib_geohash_rev_cpp,                   1},
+    {"_geographiclib_geohash_rev_int_cpp",               (DL_FUNC) &_geographiclib_geohash_rev_int_cpp,               4},
+    {"_geographiclib_geometry_area_cpp",                 (DL_FUNC) &_geographiclib_geometry_area_cpp,                 4},
+    {"_geographiclib_geometry_densify_cpp",              (DL_FUNC) &_geographiclib_geometry_densify_cpp,              5},
+    {"_geographiclib_geometry_length_cpp",               (DL_FUNC) &_geographiclib_geometry_length_cpp,               4},
     {"_geographiclib_georef_fwd_cpp",                    (DL_FUNC) &_geographiclib_georef_fwd_cpp,                    3},
     {"_geographiclib_georef_rev_cpp",                    (DL_FUNC) &_geographiclib_georef_rev_cpp,                    1},
     {"_geographiclib_gnomonic_fwd_cpp",                  (DL_FUNC) &_geographiclib_gnomonic_fwd_cpp,                  4},
@@ -653,41 +956,72 @@ static const R_CallMethodDef CallEntries[] = {
     {"_geographiclib_intersect_all_cpp",                 (DL_FUNC) &_geographiclib_intersect_all_cpp,                 7},
     {"_geographiclib_intersect_closest_cpp",             (DL_FUNC) &_geographiclib_intersect_closest_cpp,             6},
     {"_geographiclib_intersect_next_cpp",                (DL_FUNC) &_geographiclib_intersect_next_cpp,                4},
+    {"_geographiclib_intersect_polylines_cpp",           (DL_FUNC) &_geographiclib_intersect_polylines_cpp,           7},
     {"_geographiclib_intersect_segment_cpp",             (DL_FUNC) &_geographiclib_intersect_segment_cpp,             8},
-    {"_geographiclib_lcc_fwd2_cpp",                      (DL_FUNC) &_geographiclib_lcc_fwd2_cpp,                      7},
-    {"_geographiclib_lcc_fwd_cpp",                       (DL_FUNC) &_geographiclib_lcc_fwd_cpp,                       6},
-    {"_geographiclib_lcc_rev2_cpp",                      (DL_FUNC) &_geographiclib_lcc_rev2_cpp,                      7},
-    {"_geographiclib_lcc_rev_cpp",                       (DL_FUNC) &_geographiclib_lcc_rev_cpp,                       6},
-    {"_geographiclib_localcartesian_fwd_cpp",            (DL_FUNC) &_geographiclib_localcartesian_fwd_cpp,            6},
-    {"_geographiclib_localcartesian_rev_cpp",            (DL_FUNC) &_geographiclib_localcartesian_rev_cpp,            6},
+    {"_geographiclib_lcc_fwd2_cpp",                      (DL_FUNC) &_geographiclib_lcc_fwd2_cpp,                      8},
+    {"_geographiclib_lcc_fwd_cpp",                       (DL_FUNC) &_geographiclib_lcc_fwd_cpp,                       7},
+    {"_geographiclib_lcc_rev2_cpp",                      (DL_FUNC) &_geographiclib_lcc_rev2_cpp,                      8},
+    {"_geographiclib_lcc_rev_cpp",                       (DL_FUNC) &_geographiclib_lcc_rev_cpp,                       7},
+    {"_geographiclib_localcartesian_fwd_cpp",            (DL_FUNC) &_geographiclib_localcartesian_fwd_cpp,            7},
+    {"_geographiclib_localcartesian_rev_cpp",            (DL_FUNC) &_geographiclib_localcartesian_rev_cpp,            7},
     {"_geographiclib_mgrs_decode_cpp",                   (DL_FUNC) &_geographiclib_mgrs_decode_cpp,                   1},
-    {"_geographiclib_mgrs_fwd_cpp",                      (DL_FUNC) &_geographiclib_mgrs_fwd_cpp,                      3},
-    {"_geographiclib_mgrs_rev_cpp",                      (DL_FUNC) &_geographiclib_mgrs_rev_cpp,                      1},
-    {"_geographiclib_nn_search_cpp",                     (DL_FUNC) &_geographiclib_nn_search_cpp,                     5},
-    {"_geographiclib_nn_search_radius_cpp",              (DL_FUNC) &_geographiclib_nn_search_radius_cpp,              5},
-    {"_geographiclib_osgb_fwd_cpp",                      (DL_FUNC) &_geographiclib_osgb_fwd_cpp,                      2},
+    {"_geographiclib_mgrs_fwd_cpp",                      (DL_FUNC) &_geographiclib_mgrs_fwd_cpp,                      4},
+    {"_geographiclib_mgrs_rev_cpp",                      (DL_FUNC) &_geographiclib_mgrs_rev_cpp,                      5},
+    {"_geographiclib_nn_index_build_cpp",                (DL_FUNC) &_geographiclib_nn_index_build_cpp,                4},
+    {"_geographiclib_nn_index_compact_cpp",              (DL_FUNC) &_geographiclib_nn_index_compact_cpp,              2},
+    {"_geographiclib_nn_index_insert_cpp",               (DL_FUNC) &_geographiclib_nn_index_insert_cpp,               4},
+    {"_geographiclib_nn_index_load_cpp",                 (DL_FUNC) &_geographiclib_nn_index_load_cpp,                 1},
+    {"_geographiclib_nn_index_method_cpp",               (DL_FUNC) &_geographiclib_nn_index_method_cpp,               1},
+    {"_geographiclib_nn_index_remove_cpp",               (DL_FUNC) &_geographiclib_nn_index_remove_cpp,               3},
+    {"_geographiclib_nn_index_save_cpp",                 (DL_FUNC) &_geographiclib_nn_index_save_cpp,                 2},
+    {"_geographiclib_nn_index_search_cpp",               (DL_FUNC) &_geographiclib_nn_index_search_cpp,               5},
+    {"_geographiclib_nn_index_search_radius_cpp",        (DL_FUNC) &_geographiclib_nn_index_search_radius_cpp,        6},
+    {"_geographiclib_nn_index_size_cpp",                 (DL_FUNC) &_geographiclib_nn_index_size_cpp,                 1},
+    {"_geographiclib_nn_index_stats_cpp",                (DL_FUNC) &_geographiclib_nn_index_stats_cpp,                1},
+    {"_geographiclib_nn_search_cpp",                     (DL_FUNC) &_geographiclib_nn_search_cpp,                     6},
+    {"_geographiclib_nn_search_radius_cpp",              (DL_FUNC) &_geographiclib_nn_search_radius_cpp,              7},
+    {"_geographiclib_osgb_fwd_cpp",                      (DL_FUNC) &_geographiclib_osgb_fwd_cpp,                      3},
     {"_geographiclib_osgb_gridref_cpp",                  (DL_FUNC) &_geographiclib_osgb_gridref_cpp,                  3},
     {"_geographiclib_osgb_gridref_rev_cpp",              (DL_FUNC) &_geographiclib_osgb_gridref_rev_cpp,              1},
-    {"_geographiclib_osgb_rev_cpp",                      (DL_FUNC) &_geographiclib_osgb_rev_cpp,                      2},
-    {"_geographiclib_polarstereo_fwd_cpp",               (DL_FUNC) &_geographiclib_polarstereo_fwd_cpp,               4},
-    {"_geographiclib_polarstereo_fwd_custom_cpp",        (DL_FUNC) &_geographiclib_polarstereo_fwd_custom_cpp,        4},
-    {"_geographiclib_polarstereo_rev_cpp",               (DL_FUNC) &_geographiclib_polarstereo_rev_cpp,               4},
-    {"_geographiclib_polarstereo_rev_custom_cpp",        (DL_FUNC) &_geographiclib_polarstereo_rev_custom_cpp,        4},
-    {"_geographiclib_polygonarea_cpp",                   (DL_FUNC) &_geographiclib_polygonarea_cpp,                   4},
+    {"_geographiclib_osgb_rev_cpp",                      (DL_FUNC) &_geographiclib_osgb_rev_cpp,                      3},
+    {"_geographiclib_parallel_grain_size_cpp",           (DL_FUNC) &_geographiclib_parallel_grain_size_cpp,           1},
+    {"_geographiclib_parallel_shutdown_cpp",             (DL_FUNC) &_geographiclib_parallel_shutdown_cpp,             0},
+    {"_geographiclib_parallel_threads_cpp",              (DL_FUNC) &_geographiclib_parallel_threads_cpp,              1},
+    {"_geographiclib_polarstereo_fwd_cpp",               (DL_FUNC) &_geographiclib_polarstereo_fwd_cpp,               5},
+    {"_geographiclib_polarstereo_fwd_custom_cpp",        (DL_FUNC) &_geographiclib_polarstereo_fwd_custom_cpp,        5},
+    {"_geographiclib_polarstereo_rev_cpp",               (DL_FUNC) &_geographiclib_polarstereo_rev_cpp,               5},
+    {"_geographiclib_polarstereo_rev_custom_cpp",        (DL_FUNC) &_geographiclib_polarstereo_rev_custom_cpp,        5},
+    {"_geographiclib_polygon_accumulator_add_cpp",       (DL_FUNC) &_geographiclib_polygon_accumulator_add_cpp,       5},
+    {"_geographiclib_polygon_accumulator_new_cpp",       (DL_FUNC) &_geographiclib_polygon_accumulator_new_cpp,       2},
+    {"_geographiclib_polygon_accumulator_restore_cpp",   (DL_FUNC) &_geographiclib_polygon_accumulator_restore_cpp,   13},
+    {"_geographiclib_polygon_accumulator_result_cpp",    (DL_FUNC) &_geographiclib_polygon_accumulator_result_cpp,    3},
+    {"_geographiclib_polygon_accumulator_size_cpp",      (DL_FUNC) &_geographiclib_polygon_accumulator_size_cpp,      1},
+    {"_geographiclib_polygon_accumulator_snapshot_cpp",  (DL_FUNC) &_geographiclib_polygon_accumulator_snapshot_cpp,  1},
+    {"_geographiclib_polygon_validity_cpp",              (DL_FUNC) &_geographiclib_polygon_validity_cpp,              5},
+    {"_geographiclib_polygonarea_cpp",                   (DL_FUNC) &_geographiclib_polygonarea_cpp,                   7},
     {"_geographiclib_polygonarea_cumulative_cpp",        (DL_FUNC) &_geographiclib_polygonarea_cumulative_cpp,        3},
     {"_geographiclib_polygonarea_single_cpp",            (DL_FUNC) &_geographiclib_polygonarea_single_cpp,            3},
+    {"_geographiclib_projection_create_cpp",             (DL_FUNC) &_geographiclib_projection_create_cpp,             6},
+    {"_geographiclib_projection_fwd_cpp",                (DL_FUNC) &_geographiclib_projection_fwd_cpp,                6},
+    {"_geographiclib_projection_info_cpp",               (DL_FUNC) &_geographiclib_projection_info_cpp,               1},
+    {"_geographiclib_projection_rev_cpp",                (DL_FUNC) &_geographiclib_projection_rev_cpp,                6},
+    {"_geographiclib_projection_valid_cpp",              (DL_FUNC) &_geographiclib_projection_valid_cpp,              1},
     {"_geographiclib_rhumb_direct_cpp",                  (DL_FUNC) &_geographiclib_rhumb_direct_cpp,                  4},
-    {"_geographiclib_rhumb_distance_matrix_cpp",         (DL_FUNC) &_geographiclib_rhumb_distance_matrix_cpp,         4},
+    {"_geographiclib_rhumb_distance_matrix_cpp",         (DL_FUNC) &_geographiclib_rhumb_distance_matrix_cpp,         5},
     {"_geographiclib_rhumb_distance_pairwise_cpp",       (DL_FUNC) &_geographiclib_rhumb_distance_pairwise_cpp,       4},
     {"_geographiclib_rhumb_inverse_cpp",                 (DL_FUNC) &_geographiclib_rhumb_inverse_cpp,                 4},
     {"_geographiclib_rhumb_line_cpp",                    (DL_FUNC) &_geographiclib_rhumb_line_cpp,                    4},
     {"_geographiclib_rhumb_path_cpp",                    (DL_FUNC) &_geographiclib_rhumb_path_cpp,                    5},
-    {"_geographiclib_tm_exact_fwd_cpp",                  (DL_FUNC) &_geographiclib_tm_exact_fwd_cpp,                  4},
-    {"_geographiclib_tm_exact_rev_cpp",                  (DL_FUNC) &_geographiclib_tm_exact_rev_cpp,                  4},
-    {"_geographiclib_tm_fwd_cpp",                        (DL_FUNC) &_geographiclib_tm_fwd_cpp,                        4},
-    {"_geographiclib_tm_rev_cpp",                        (DL_FUNC) &_geographiclib_tm_rev_cpp,                        4},
-    {"_geographiclib_utmups_fwd_cpp",                    (DL_FUNC) &_geographiclib_utmups_fwd_cpp,                    2},
-    {"_geographiclib_utmups_rev_cpp",                    (DL_FUNC) &_geographiclib_utmups_rev_cpp,                    4},
+    {"_geographiclib_tm_exact_fwd_cpp",                  (DL_FUNC) &_geographiclib_tm_exact_fwd_cpp,                  5},
+    {"_geographiclib_tm_exact_rev_cpp",                  (DL_FUNC) &_geographiclib_tm_exact_rev_cpp,                  5},
+    {"_geographiclib_tm_fwd_cpp",                        (DL_FUNC) &_geographiclib_tm_fwd_cpp,                        5},
+    {"_geographiclib_tm_rev_cpp",                        (DL_FUNC) &_geographiclib_tm_rev_cpp,                        5},
+    {"_geographiclib_transform_apply_cpp",               (DL_FUNC) &_geographiclib_transform_apply_cpp,               5},
+    {"_geographiclib_transform_create_cpp",              (DL_FUNC) &_geographiclib_transform_create_cpp,              12},
+    {"_geographiclib_transform_grid_cpp",                (DL_FUNC) &_geographiclib_transform_grid_cpp,                7},
+    {"_geographiclib_transform_valid_cpp",               (DL_FUNC) &_geographiclib_transform_valid_cpp,               1},
+    {"_geographiclib_utmups_fwd_cpp",                    (DL_FUNC) &_geographiclib_utmups_fwd_cpp,                    5},
+    {"_geographiclib_utmups_rev_cpp",                    (DL_FUNC) &_geographiclib_utmups_rev_cpp,                    7},
     {NULL, NULL, 0}
 };
 }